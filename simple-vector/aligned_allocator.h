@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Распределитель, выравнивающий каждый блок по границе Alignment байт (например, 32 для AVX2
+// или 64 - размер кэш-линии). Позволяет SIMD-коду рассчитывать на выровненное начало массива:
+//     SimpleVector<float, AlignedAllocator<float, 32>> v;
+template <typename Type, size_t Alignment = 64>
+class AlignedAllocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(Type), "Alignment must not be weaker than alignof(Type)");
+
+public:
+    using value_type = Type;
+    using is_always_equal = std::true_type;
+
+    static constexpr size_t alignment = Alignment;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = AlignedAllocator<Other, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment>&) noexcept
+    {
+    }
+
+    Type* allocate(size_t size)
+    {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type))
+        {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(::operator new(size * sizeof(Type), std::align_val_t{ Alignment }));
+    }
+
+    void deallocate(Type* ptr, size_t) noexcept
+    {
+        ::operator delete(ptr, std::align_val_t{ Alignment });
+    }
+};
+
+template <typename Lhs, typename Rhs, size_t Alignment>
+inline bool operator==(const AlignedAllocator<Lhs, Alignment>&, const AlignedAllocator<Rhs, Alignment>&) noexcept
+{
+    return true;
+}
+
+template <typename Lhs, typename Rhs, size_t Alignment>
+inline bool operator!=(const AlignedAllocator<Lhs, Alignment>&, const AlignedAllocator<Rhs, Alignment>&) noexcept
+{
+    return false;
+}
@@ -1,39 +1,86 @@
 // вставьте сюда ваш код для класса ArrayPtr
-// внесиnте в него изменения, 
+// внесиnте в него изменения,
 // которые позволят реализовать move-семантику
 
 #pragma once
 
+#include <algorithm>      //для std::fill()
 #include <cassert>
 #include <cstdlib>
+#include <cstring>        //для std::memcpy(), std::memmove()
+#include <memory>         //для std::allocator, std::allocator_traits
 #include <string_view>    //для std::swap()
+#include <type_traits>
 #include <utility>        //для std::exchange()
 
+#include "simd_kernels.h"
+
+// Признак того, что объект Type можно переместить в другой адрес побайтовым копированием памяти,
+// после чего исходный объект считается несуществующим (деструктор для него не вызывается).
+// По умолчанию истинен для тривиально копируемых типов. Для прочих типов (например, владеющих
+// указателем на кучу, но не хранящих указатели на самих себя) его можно включить специализацией:
+//     template <> struct is_trivially_relocatable<MyType> : std::true_type {};
+template <typename Type>
+struct is_trivially_relocatable : std::is_trivially_copyable<Type>
+{
+};
+
 template <typename Type>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<Type>::value;
+
+// Признак наличия у распределителя метода reallocate(ptr, old_size, new_size),
+// изменяющего размер блока с сохранением содержимого (например, через realloc/mremap)
+template <typename Allocator, typename = void>
+struct has_reallocate : std::false_type
+{
+};
+
+template <typename Allocator>
+struct has_reallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+    std::declval<typename std::allocator_traits<Allocator>::pointer>(), size_t{}, size_t{}))>> : std::true_type
+{
+};
+
+// ArrayPtr владеет "сырой" (неинициализированной) памятью под size элементов типа Type,
+// полученной от распределителя Allocator через std::allocator_traits.
+// Конструирование и разрушение элементов выполняет владелец ArrayPtr (SimpleVector)
+// через методы Construct/Destroy/Uninitialized*, поэтому резервирование емкости не вызывает
+// конструкторов Type
+template <typename Type, typename Allocator = std::allocator<Type>>
 class ArrayPtr
 {
 public:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, Type>,
+                  "Allocator::value_type must be the same as Type");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, Type*>,
+                  "Fancy pointers are not supported");
+
     // Инициализирует ArrayPtr нулевым указателем
     ArrayPtr() = default;
 
-    // Создаёт в куче массив из size элементов типа Type.
+    // Инициализирует ArrayPtr нулевым указателем с заданным распределителем
+    explicit ArrayPtr(const Allocator& alloc) noexcept : alloc_(alloc)
+    {
+    }
+
+    // Выделяет неинициализированную память под size элементов типа Type.
     // Если size == 0, поле raw_ptr_ должно быть равно nullptr
-    explicit ArrayPtr(size_t size)
+    explicit ArrayPtr(size_t size, const Allocator& alloc = Allocator()) : alloc_(alloc)
     {
         if (size != 0)
         {
-            raw_ptr_ = new Type[size];
+            raw_ptr_ = AllocTraits::allocate(alloc_, size);
+            size_ = size;
         }
     }
 
-    // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
-    explicit ArrayPtr(Type* raw_ptr) noexcept
+    // Конструктор из сырого указателя, хранящего адрес памяти под size элементов,
+    // полученной от распределителя alloc (например, через Release()), либо nullptr
+    ArrayPtr(Type* raw_ptr, size_t size, const Allocator& alloc = Allocator()) noexcept
+        : raw_ptr_(raw_ptr), size_(raw_ptr != nullptr ? size : 0), alloc_(alloc)
     {
-        if (raw_ptr_ != nullptr)
-        {
-            delete[] raw_ptr_;
-        }
-        raw_ptr_ = raw_ptr;
     }
 
     // Запрещаем конструктор копирования
@@ -43,52 +90,63 @@ public:
     ArrayPtr& operator=(const ArrayPtr&) = delete;
 
     // Конструктор перемещения.
-    // Забирает массив у объекта-источника.
-    ArrayPtr(ArrayPtr&& source)
+    // Забирает массив и распределитель у объекта-источника.
+    ArrayPtr(ArrayPtr&& source) noexcept
+        : raw_ptr_(std::exchange(source.raw_ptr_, nullptr))
+        , size_(std::exchange(source.size_, 0))
+        , alloc_(std::move(source.alloc_))
     {
-        // Присваиваем указатель на массив
-// Марина М.: std::exchange или свапнуть
-//raw_ptr_ = source.raw_ptr_;
-// Стираем указатель у источника
-//source.raw_ptr_ = nullptr;
-        raw_ptr_ = std::exchange(source.raw_ptr_, nullptr);
     }
 
     // Оператор присваивания перемещением.
-    // Забирает массив у объекта-источника.
-    ArrayPtr& operator=(ArrayPtr&& source)
+    // Забирает массив у объекта-источника. Распределитель передается, только если
+    // propagate_on_container_move_assignment, иначе распределители обязаны быть равны
+    ArrayPtr& operator=(ArrayPtr&& source) noexcept
     {
-        // Если raw_ptr уже что-то хранит, это ошибка.
-        // Можно молча удалить имеющееся, либо остановить выполнение assert'ом
-#ifdef _DEBUG
-        assert(this->raw_ptr_ == nullptr);
-#else
-        delete this->raw_ptr_;
-#endif // !DEBUG_
-
-        // Присваиваем указатель на массив
-// Марина М.: std::exchange или свапнуть
-//raw_ptr_ = source.raw_ptr_;
-// Стираем указатель у источника
-//source.raw_ptr_ = nullptr;
-        raw_ptr_ = std::exchange(source.raw_ptr_, nullptr);
+        if (this != &source)
+        {
+            // Элементы в памяти уже должны быть разрушены владельцем, освобождаем только память
+            Deallocate();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+            {
+                alloc_ = std::move(source.alloc_);
+            }
+            else
+            {
+                assert(alloc_ == source.alloc_);
+            }
+            raw_ptr_ = std::exchange(source.raw_ptr_, nullptr);
+            size_ = std::exchange(source.size_, 0);
+        }
+        return *this;
     }
 
+    // Освобождает память. Деструкторы элементов не вызываются
     ~ArrayPtr()
     {
-        delete[] raw_ptr_;
+        Deallocate();
     }
 
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
     // После вызова метода указатель на массив должен обнулиться
     [[nodiscard]] Type* Release() noexcept
     {
-        Type* tmp_ptr = raw_ptr_;
+        size_ = 0;
+        return std::exchange(raw_ptr_, nullptr);
+    }
+
+    // Освобождает память и заменяет распределитель на alloc.
+    // Используется владельцем при propagate_on_container_copy_assignment
+    void ResetAllocator(const Allocator& alloc)
+    {
+        Deallocate();
         raw_ptr_ = nullptr;
-        return tmp_ptr;
+        size_ = 0;
+        alloc_ = alloc;
     }
 
-    // Возвращает ссылку на элемент массива с индексом index
+    // Возвращает ссылку на элемент массива с индексом index.
+    // Элемент должен быть предварительно сконструирован владельцем
     Type& operator[](size_t index) noexcept
     {
         return *(raw_ptr_ + index);
@@ -113,14 +171,229 @@ public:
         return raw_ptr_;
     }
 
-    // Обменивается значениям указателя на массив с объектом other
+    // Возвращает количество элементов, под которые выделена память
+    size_t GetSize() const noexcept
+    {
+        return size_;
+    }
+
+    // Возвращает распределитель памяти
+    const Allocator& GetAllocator() const noexcept
+    {
+        return alloc_;
+    }
+
+    // Обменивается значениям указателя на массив с объектом other.
+    // Распределители обмениваются, только если propagate_on_container_swap,
+    // иначе они обязаны быть равны
     void swap(ArrayPtr& other) noexcept
     {
         std::swap(this->raw_ptr_, other.raw_ptr_);
+        std::swap(this->size_, other.size_);
+        if constexpr (AllocTraits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(this->alloc_, other.alloc_);
+        }
+        else
+        {
+            assert(this->alloc_ == other.alloc_);
+        }
+    }
+
+    // Изменяет размер блока памяти до new_size элементов, сохраняя первые used элементов.
+    // Доступно только для тривиально перемещаемых типов: если распределитель умеет reallocate,
+    // блок расширяется на месте (или переносится системой), иначе копируется через memcpy
+    void Reallocate(size_t new_size, size_t used)
+    {
+        static_assert(is_trivially_relocatable_v<Type>, "Reallocate requires a trivially relocatable type");
+        assert(used <= size_ && used <= new_size);
+
+        if (new_size == 0)
+        {
+            Deallocate();
+            raw_ptr_ = nullptr;
+            size_ = 0;
+            return;
+        }
+
+        if constexpr (has_reallocate<Allocator>::value)
+        {
+            if (raw_ptr_ != nullptr)
+            {
+                raw_ptr_ = alloc_.reallocate(raw_ptr_, size_, new_size);
+                size_ = new_size;
+                return;
+            }
+        }
+
+        ArrayPtr buffer(new_size, alloc_);
+        RawCopy(raw_ptr_, used, buffer.raw_ptr_);
+        swap(buffer);
+    }
+
+    // Конструирует элемент по адресу ptr внутри массива из args
+    template <typename... Args>
+    void Construct(Type* ptr, Args&&... args)
+    {
+        AllocTraits::construct(alloc_, ptr, std::forward<Args>(args)...);
+    }
+
+    // Разрушает элементы [first, last)
+    void Destroy(Type* first, Type* last) noexcept
+    {
+        for (; first != last; ++first)
+        {
+            AllocTraits::destroy(alloc_, first);
+        }
+    }
+
+    // Копирует [first, last) в неинициализированную память dest.
+    // При исключении уже созданные элементы разрушаются. Возвращает конец созданного диапазона
+    template <typename InputIt>
+    Type* UninitializedCopy(InputIt first, InputIt last, Type* dest)
+    {
+        if constexpr (std::is_trivially_copyable_v<Type>
+                      && (std::is_same_v<InputIt, Type*> || std::is_same_v<InputIt, const Type*>))
+        {
+            const size_t count = static_cast<size_t>(last - first);
+            RawCopy(first, count, dest);
+            return dest + count;
+        }
+
+        Type* current = dest;
+        try
+        {
+            for (; first != last; ++first, ++current)
+            {
+                Construct(current, *first);
+            }
+        }
+        catch (...)
+        {
+            Destroy(dest, current);
+            throw;
+        }
+        return current;
+    }
+
+    // Перемещает [first, last) в неинициализированную память dest
+    Type* UninitializedMove(Type* first, Type* last, Type* dest)
+    {
+        if constexpr (std::is_trivially_copyable_v<Type>)
+        {
+            return UninitializedCopy(first, last, dest);
+        }
+        return UninitializedCopy(std::make_move_iterator(first), std::make_move_iterator(last), dest);
+    }
+
+    // Переносит объекты [first, last) в неинициализированную память dest.
+    // После вызова исходный диапазон считается неинициализированной памятью
+    Type* Relocate(Type* first, Type* last, Type* dest)
+    {
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            const size_t count = static_cast<size_t>(last - first);
+            RawCopy(first, count, dest);
+            return dest + count;
+        }
+        else
+        {
+            Type* result = UninitializedMove(first, last, dest);
+            Destroy(first, last);
+            return result;
+        }
+    }
+
+    // Конструирует копии value в неинициализированной памяти [first, last)
+    Type* UninitializedFill(Type* first, Type* last, const Type& value)
+    {
+        if constexpr (simd::is_supported_v<Type>)
+        {
+            simd::Fill(first, static_cast<size_t>(last - first), value);
+            return last;
+        }
+        else if constexpr (std::is_trivially_copyable_v<Type>)
+        {
+            std::fill(first, last, value);
+            return last;
+        }
+
+        Type* current = first;
+        try
+        {
+            for (; current != last; ++current)
+            {
+                Construct(current, value);
+            }
+        }
+        catch (...)
+        {
+            Destroy(first, current);
+            throw;
+        }
+        return current;
+    }
+
+    // Конструирует элементы со значением по умолчанию в неинициализированной памяти [first, last)
+    Type* UninitializedValueConstruct(Type* first, Type* last)
+    {
+        if constexpr (simd::is_supported_v<Type>)
+        {
+            simd::Fill(first, static_cast<size_t>(last - first), Type());
+            return last;
+        }
+        else if constexpr (std::is_trivial_v<Type> && std::is_copy_assignable_v<Type>)
+        {
+            std::fill(first, last, Type());
+            return last;
+        }
+
+        Type* current = first;
+        try
+        {
+            for (; current != last; ++current)
+            {
+                Construct(current);
+            }
+        }
+        catch (...)
+        {
+            Destroy(first, current);
+            throw;
+        }
+        return current;
+    }
+
+    // Сдвигает count тривиально перемещаемых объектов с адреса src на адрес dest (диапазоны
+    // могут перекрываться). Память, которую объекты покинули, становится неинициализированной
+    static void RawShift(const Type* src, size_t count, Type* dest) noexcept
+    {
+        static_assert(is_trivially_relocatable_v<Type>, "RawShift requires a trivially relocatable type");
+        if (count != 0)
+        {
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(Type));
+        }
     }
 
 private:
     Type* raw_ptr_ = nullptr;
+    size_t size_ = 0;        // Количество элементов, под которые выделена память
+    Allocator alloc_{};
+
+    static void RawCopy(const Type* src, size_t count, Type* dest) noexcept
+    {
+        if (count != 0)
+        {
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(Type));
+        }
+    }
 
-    // ArrayPtr не хранит размер массива -> следить нужно вручную
+    void Deallocate() noexcept
+    {
+        if (raw_ptr_ != nullptr)
+        {
+            AllocTraits::deallocate(alloc_, raw_ptr_, size_);
+        }
+    }
 };
@@ -0,0 +1,1115 @@
+// Сравнительные замеры SimpleVector и std::vector.
+// Результат выводится в stdout в формате CSV:
+//     container,growth,element,operation,size,iterations,total_ns,ns_per_op
+// growth - политика роста емкости SimpleVector (см. growth_policy.h), для std::vector - "std"
+// Параметры командной строки:
+//     --min-size N   минимальный размер вектора (по умолчанию 10)
+//     --max-size N   максимальный размер вектора (по умолчанию 10000000), размеры растут в 10 раз
+//     --repeat R     число повторов каждого замера, выводится лучший результат (по умолчанию 3)
+// В строках с операцией heap_allocations колонка iterations - число обращений к системному
+// распределителю за один прогон, время не замеряется
+
+#include "bit_vector.h"
+#include "concurrent_simple_vector.h"
+#include "flat_set.h"
+#include "incremental_simple_vector.h"
+#include "mmap_allocator.h"
+#include "pool_allocator.h"
+#include "segmented_simple_vector.h"
+#include "shared_simple_vector.h"
+#include "simple_vector.h"
+#include "soa_vector.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+
+// Некопируемый тип, аналог X из main.cpp
+class X
+{
+public:
+    X() : X(5)
+    {
+    }
+
+    explicit X(size_t num) : x_(num)
+    {
+    }
+
+    X(const X& other) = delete;
+    X& operator=(const X& other) = delete;
+
+    X(X&& other) noexcept : x_(std::exchange(other.x_, 0))
+    {
+    }
+
+    X& operator=(X&& other) noexcept
+    {
+        x_ = std::exchange(other.x_, 0);
+        return *this;
+    }
+
+    size_t GetX() const
+    {
+        return x_;
+    }
+
+private:
+    size_t x_;
+};
+
+// Запись из нескольких полей (64 байта) для сравнения массива структур SimpleVector<Record>
+// и структуры массивов SoaVector: горячие циклы читают одно-два поля из пяти
+struct Record
+{
+    int id;
+    int quantity;
+    double price;
+    long long timestamp;
+    char tag[40];
+};
+
+// Количество вставок/удалений для замеров Insert/Erase: на больших векторах
+// каждая операция линейна, поэтому их число ограничено
+constexpr size_t MAX_SHIFT_OPS = 1000;
+
+// Результат, который компилятор не может выбросить как неиспользуемый
+volatile size_t benchmark_sink = 0;
+
+template <typename Type>
+Type MakeValue(size_t i)
+{
+    if constexpr (std::is_same_v<Type, std::string>)
+    {
+        // Строка длиннее SSO-буфера, чтобы копирование обращалось к куче
+        return "benchmark-value-"s + std::to_string(i);
+    }
+    else
+    {
+        return Type(i);
+    }
+}
+
+template <typename Type>
+struct TypeName;
+
+template <>
+struct TypeName<int>
+{
+    static constexpr std::string_view value = "int";
+};
+
+template <>
+struct TypeName<std::string>
+{
+    static constexpr std::string_view value = "string";
+};
+
+template <>
+struct TypeName<X>
+{
+    static constexpr std::string_view value = "X";
+};
+
+template <>
+struct TypeName<bool>
+{
+    static constexpr std::string_view value = "bool";
+};
+
+template <>
+struct TypeName<Record>
+{
+    static constexpr std::string_view value = "record";
+};
+
+// Единый интерфейс к SimpleVector и std::vector для шаблонных замеров
+template <typename Type, typename GrowthPolicy = DoublingGrowth, typename Allocator = std::allocator<Type>>
+struct SimpleVectorOps
+{
+    using Container = SimpleVector<Type, Allocator, GrowthPolicy>;
+    static constexpr std::string_view name = std::is_same_v<Allocator, std::allocator<Type>> ? "SimpleVector"sv
+                                                                                             : "SimpleVector+mmap"sv;
+    static constexpr std::string_view growth = GrowthPolicy::name;
+
+    static void PushBack(Container& v, Type&& value)
+    {
+        v.PushBack(std::move(value));
+    }
+
+    static void Reserve(Container& v, size_t n)
+    {
+        v.Reserve(n);
+    }
+
+    static void Resize(Container& v, size_t n)
+    {
+        v.Resize(n);
+    }
+
+    static void Insert(Container& v, size_t pos, Type&& value)
+    {
+        v.Insert(v.begin() + pos, std::move(value));
+    }
+
+    static void Erase(Container& v, size_t pos)
+    {
+        v.Erase(v.begin() + pos);
+    }
+
+    template <typename Predicate>
+    static void EraseIf(Container& v, Predicate pred)
+    {
+        v.EraseIf(pred);
+    }
+
+    static size_t Size(const Container& v)
+    {
+        return v.GetSize();
+    }
+};
+
+template <typename Type>
+struct StdVectorOps
+{
+    using Container = std::vector<Type>;
+    static constexpr std::string_view name = "std::vector";
+    static constexpr std::string_view growth = "std";
+
+    static void PushBack(Container& v, Type&& value)
+    {
+        v.push_back(std::move(value));
+    }
+
+    static void Reserve(Container& v, size_t n)
+    {
+        v.reserve(n);
+    }
+
+    static void Resize(Container& v, size_t n)
+    {
+        v.resize(n);
+    }
+
+    static void Insert(Container& v, size_t pos, Type&& value)
+    {
+        v.insert(v.begin() + static_cast<std::ptrdiff_t>(pos), std::move(value));
+    }
+
+    static void Erase(Container& v, size_t pos)
+    {
+        v.erase(v.begin() + static_cast<std::ptrdiff_t>(pos));
+    }
+
+    template <typename Predicate>
+    static void EraseIf(Container& v, Predicate pred)
+    {
+        v.erase(std::remove_if(v.begin(), v.end(), pred), v.end());
+    }
+
+    static size_t Size(const Container& v)
+    {
+        return v.size();
+    }
+};
+
+template <typename Type>
+struct SegmentedSimpleVectorOps
+{
+    using Container = SegmentedSimpleVector<Type>;
+    static constexpr std::string_view name = "SegmentedSimpleVector";
+    static constexpr std::string_view growth = "blocks";
+
+    static void PushBack(Container& v, Type&& value)
+    {
+        v.PushBack(std::move(value));
+    }
+
+    static void Reserve(Container& v, size_t n)
+    {
+        v.Reserve(n);
+    }
+
+    static size_t Size(const Container& v)
+    {
+        return v.GetSize();
+    }
+};
+
+template <typename Type>
+struct IncrementalSimpleVectorOps
+{
+    using Container = IncrementalSimpleVector<Type>;
+    static constexpr std::string_view name = "IncrementalSimpleVector";
+    static constexpr std::string_view growth = DoublingGrowth::name;
+
+    static void PushBack(Container& v, Type&& value)
+    {
+        v.PushBack(std::move(value));
+    }
+
+    static void Reserve(Container& v, size_t n)
+    {
+        v.Reserve(n);
+    }
+
+    static size_t Size(const Container& v)
+    {
+        return v.GetSize();
+    }
+};
+
+// Секундомер замера. Тело замера может перезапустить его после подготовки данных
+// и должно остановить до разрушения контейнеров
+class Stopwatch
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void Restart()
+    {
+        start_ = Clock::now();
+        stopped_ = false;
+    }
+
+    void Stop()
+    {
+        if (!stopped_)
+        {
+            elapsed_ = Clock::now() - start_;
+            stopped_ = true;
+        }
+    }
+
+    long long ElapsedNs() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed_).count();
+    }
+
+private:
+    Clock::time_point start_ = Clock::now();
+    Clock::duration elapsed_{};
+    bool stopped_ = false;
+};
+
+struct Options
+{
+    size_t min_size = 10;
+    size_t max_size = 10'000'000;
+    size_t repeat = 3;
+};
+
+// Выполняет body(stopwatch) options.repeat раз и печатает лучшее время.
+// body возвращает количество выполненных операций
+template <typename Ops, typename Type, typename Body>
+void Measure(const Options& options, std::string_view operation, size_t size, Body body)
+{
+    long long best_ns = -1;
+    size_t iterations = 0;
+    for (size_t i = 0; i < options.repeat; ++i)
+    {
+        Stopwatch stopwatch;
+        stopwatch.Restart();
+        iterations = body(stopwatch);
+        stopwatch.Stop();
+        const long long elapsed = stopwatch.ElapsedNs();
+        if (best_ns < 0 || elapsed < best_ns)
+        {
+            best_ns = elapsed;
+        }
+    }
+
+    std::cout << Ops::name << ',' << Ops::growth << ',' << TypeName<Type>::value << ',' << operation << ',' << size << ','
+              << iterations << ',' << best_ns << ','
+              << (iterations > 0 ? static_cast<double>(best_ns) / static_cast<double>(iterations) : 0.0) << '\n';
+}
+
+template <typename Ops, typename Type>
+typename Ops::Container MakeFilled(size_t size)
+{
+    typename Ops::Container v;
+    Ops::Reserve(v, size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        Ops::PushBack(v, MakeValue<Type>(i));
+    }
+    return v;
+}
+
+// Замеры вставки и удаления в начале, середине и конце вектора размера size
+template <typename Ops, typename Type>
+void BenchmarkShifts(const Options& options, size_t size)
+{
+    const size_t ops = std::min(size, MAX_SHIFT_OPS);
+
+    const std::pair<std::string_view, int> positions[] = { { "front"sv, 0 }, { "middle"sv, 1 }, { "back"sv, 2 } };
+    for (const auto& [where, kind] : positions)
+    {
+        auto position = [kind = kind](size_t current_size) -> size_t
+            {
+                return kind == 0 ? 0 : (kind == 1 ? current_size / 2 : current_size);
+            };
+
+        Measure<Ops, Type>(options, "insert_"s + std::string(where), size, [&](Stopwatch& stopwatch)
+            {
+                auto v = MakeFilled<Ops, Type>(size);
+                stopwatch.Restart();
+                for (size_t i = 0; i < ops; ++i)
+                {
+                    Ops::Insert(v, position(Ops::Size(v)), MakeValue<Type>(i));
+                }
+                stopwatch.Stop();
+                benchmark_sink = benchmark_sink + Ops::Size(v);
+                return ops;
+            });
+
+        Measure<Ops, Type>(options, "erase_"s + std::string(where), size, [&](Stopwatch& stopwatch)
+            {
+                auto v = MakeFilled<Ops, Type>(size);
+                stopwatch.Restart();
+                for (size_t i = 0; i < ops; ++i)
+                {
+                    const size_t current = Ops::Size(v);
+                    Ops::Erase(v, kind == 2 ? current - 1 : position(current));
+                }
+                stopwatch.Stop();
+                benchmark_sink = benchmark_sink + Ops::Size(v);
+                return ops;
+            });
+    }
+}
+
+// Замер PushBack без резервирования: зависит от политики роста
+template <typename Ops, typename Type>
+void BenchmarkGrowth(const Options& options, size_t size)
+{
+    Measure<Ops, Type>(options, "push_back", size, [&](Stopwatch& stopwatch)
+        {
+            typename Ops::Container v;
+            for (size_t i = 0; i < size; ++i)
+            {
+                Ops::PushBack(v, MakeValue<Type>(i));
+            }
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + Ops::Size(v);
+            return size;
+        });
+}
+
+template <typename Ops, typename Type>
+void BenchmarkContainer(const Options& options, size_t size)
+{
+    using Container = typename Ops::Container;
+
+    BenchmarkGrowth<Ops, Type>(options, size);
+
+    Measure<Ops, Type>(options, "push_back_reserved", size, [&](Stopwatch& stopwatch)
+        {
+            Container v;
+            Ops::Reserve(v, size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                Ops::PushBack(v, MakeValue<Type>(i));
+            }
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + Ops::Size(v);
+            return size;
+        });
+
+    Measure<Ops, Type>(options, "resize", size, [&](Stopwatch& stopwatch)
+        {
+            Container v;
+            Ops::Resize(v, size);
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + Ops::Size(v);
+            return size;
+        });
+
+    BenchmarkShifts<Ops, Type>(options, size);
+
+    // Удаление каждого десятого элемента за один проход (периодическая очистка устаревших записей)
+    Measure<Ops, Type>(options, "erase_if", size, [&](Stopwatch& stopwatch)
+        {
+            auto v = MakeFilled<Ops, Type>(size);
+            size_t index = 0;
+            stopwatch.Restart();
+            Ops::EraseIf(v, [&index](const Type&)
+                {
+                    return index++ % 10 == 0;
+                });
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + Ops::Size(v);
+            return size;
+        });
+
+    Container source = MakeFilled<Ops, Type>(size);
+
+    Measure<Ops, Type>(options, "move_construct", size, [&](Stopwatch& stopwatch)
+        {
+            Container moved(std::move(source));
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + Ops::Size(moved);
+            source = std::move(moved);
+            return size_t{ 1 };
+        });
+
+    if constexpr (std::is_copy_constructible_v<Type>)
+    {
+        Measure<Ops, Type>(options, "copy_construct", size, [&](Stopwatch& stopwatch)
+            {
+                Container copy(source);
+                stopwatch.Stop();
+                benchmark_sink = benchmark_sink + Ops::Size(copy);
+                return size;
+            });
+
+        const Container other(source);
+        Measure<Ops, Type>(options, "compare_equal", size, [&](Stopwatch&)
+            {
+                benchmark_sink = benchmark_sink + static_cast<size_t>(source == other);
+                return size;
+            });
+
+        Measure<Ops, Type>(options, "compare_less", size, [&](Stopwatch&)
+            {
+                benchmark_sink = benchmark_sink + static_cast<size_t>(source < other);
+                return size;
+            });
+    }
+}
+
+// Худшее время одного PushBack при заполнении вектора до size элементов (хвостовая задержка
+// из-за переездов при росте). Выводится строкой push_back_worst с iterations = 1
+template <typename Ops, typename Type>
+void BenchmarkWorstPushBack(const Options& options, size_t size)
+{
+    using Clock = Stopwatch::Clock;
+    long long best_worst_ns = -1;
+    for (size_t repeat = 0; repeat < options.repeat; ++repeat)
+    {
+        typename Ops::Container v;
+        Clock::duration worst{};
+        for (size_t i = 0; i < size; ++i)
+        {
+            Type value = MakeValue<Type>(i);
+            const Clock::time_point start = Clock::now();
+            Ops::PushBack(v, std::move(value));
+            worst = std::max(worst, Clock::now() - start);
+        }
+        benchmark_sink = benchmark_sink + Ops::Size(v);
+        const long long worst_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(worst).count();
+        if (best_worst_ns < 0 || worst_ns < best_worst_ns)
+        {
+            best_worst_ns = worst_ns;
+        }
+    }
+    std::cout << Ops::name << ',' << Ops::growth << ',' << TypeName<Type>::value << ",push_back_worst," << size
+              << ",1," << best_worst_ns << ',' << best_worst_ns << '\n';
+}
+
+struct SharedSimpleVectorOps
+{
+    static constexpr std::string_view name = "SharedSimpleVector";
+    static constexpr std::string_view growth = DoublingGrowth::name;
+};
+
+// Снимок SharedSimpleVector (увеличение счетчика ссылок) и первая запись в снимок (клонирование)
+template <typename Type>
+void BenchmarkSnapshot(const Options& options, size_t size)
+{
+    const SharedSimpleVector<Type> source(size, MakeValue<Type>(size));
+    Measure<SharedSimpleVectorOps, Type>(options, "copy_construct", size, [&](Stopwatch& stopwatch)
+        {
+            SharedSimpleVector<Type> snapshot(source);
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + snapshot.GetSize();
+            return size;
+        });
+
+    Measure<SharedSimpleVectorOps, Type>(options, "copy_then_write", size, [&](Stopwatch& stopwatch)
+        {
+            SharedSimpleVector<Type> snapshot(source);
+            if (size > 0)
+            {
+                snapshot[0] = MakeValue<Type>(0);
+            }
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + snapshot.GetSize();
+            return size;
+        });
+}
+
+// Параллельные конструкторы и сравнение SimpleVector против последовательных
+template <typename Type>
+void BenchmarkParallel(const Options& options, size_t size)
+{
+    using Ops = SimpleVectorOps<Type>;
+    using Container = typename Ops::Container;
+    const Type value = MakeValue<Type>(size);
+
+    Measure<Ops, Type>(options, "fill_construct", size, [&](Stopwatch& stopwatch)
+        {
+            Container v(size, value);
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + Ops::Size(v);
+            return size;
+        });
+
+    Measure<Ops, Type>(options, "fill_construct_par", size, [&](Stopwatch& stopwatch)
+        {
+            Container v(parallel::par, size, value);
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + Ops::Size(v);
+            return size;
+        });
+
+    const Container source = MakeFilled<Ops, Type>(size);
+    Measure<Ops, Type>(options, "copy_construct_par", size, [&](Stopwatch& stopwatch)
+        {
+            Container copy(parallel::par, source);
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + Ops::Size(copy);
+            return size;
+        });
+
+    const Container other(source);
+    Measure<Ops, Type>(options, "compare_equal_par", size, [&](Stopwatch&)
+        {
+            benchmark_sink = benchmark_sink + static_cast<size_t>(Equal(parallel::par, source, other));
+            return size;
+        });
+}
+
+struct ConcurrentAppendOps
+{
+    static constexpr std::string_view name = "ConcurrentSimpleVector";
+    static constexpr std::string_view growth = "buckets";
+};
+
+struct MutexAppendOps
+{
+    static constexpr std::string_view name = "SimpleVector+mutex";
+    static constexpr std::string_view growth = DoublingGrowth::name;
+};
+
+// Вызывает append(i) для i из [0, size) в threads потоках и возвращает size
+template <typename Append>
+size_t RunAppenders(size_t size, size_t threads, Append append)
+{
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&append, size, threads, t]
+            {
+                for (size_t i = t; i < size; i += threads)
+                {
+                    append(i);
+                }
+            });
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    return size;
+}
+
+// Добавление из нескольких потоков: ConcurrentSimpleVector против SimpleVector под мьютексом
+void BenchmarkConcurrentAppend(const Options& options, size_t size)
+{
+    const size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+
+    Measure<ConcurrentAppendOps, int>(options, "concurrent_push_back", size, [&](Stopwatch& stopwatch)
+        {
+            ConcurrentSimpleVector<int> v;
+            RunAppenders(size, threads, [&v](size_t i)
+                {
+                    v.PushBack(static_cast<int>(i));
+                });
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + v.GetSize();
+            return size;
+        });
+
+    Measure<MutexAppendOps, int>(options, "concurrent_push_back", size, [&](Stopwatch& stopwatch)
+        {
+            SimpleVector<int> v;
+            std::mutex mutex;
+            RunAppenders(size, threads, [&v, &mutex](size_t i)
+                {
+                    std::lock_guard guard(mutex);
+                    v.PushBack(static_cast<int>(i));
+                });
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + v.GetSize();
+            return size;
+        });
+}
+
+template <typename Layout>
+struct FlatSetOps
+{
+    static constexpr std::string_view name = "FlatSet";
+    static constexpr std::string_view growth = Layout::name;
+};
+
+struct StdSetOps
+{
+    static constexpr std::string_view name = "std::set";
+    static constexpr std::string_view growth = "std";
+};
+
+// Поиск size ключей (половина отсутствует) в множестве из size ключей
+template <typename Ops, typename Set>
+void BenchmarkLookup(const Options& options, size_t size, const Set& set)
+{
+    // Псевдослучайный порядок запросов, чтобы поиски не шли по соседним ключам
+    std::vector<int> queries(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        queries[i] = static_cast<int>((i * 2654435761u) % (2 * size));
+    }
+    Measure<Ops, int>(options, "find", size, [&](Stopwatch&)
+        {
+            size_t found = 0;
+            for (int query : queries)
+            {
+                if constexpr (std::is_same_v<Ops, StdSetOps>)
+                {
+                    found += set.count(query);
+                }
+                else
+                {
+                    found += set.Count(query);
+                }
+            }
+            benchmark_sink = benchmark_sink + found;
+            return size;
+        });
+}
+
+// Поиск в FlatSet (отсортированный массив и раскладка Эйтцингера) против std::set.
+// Ключи - четные числа, так что половина запросов не находит ключ
+void BenchmarkFlatSet(const Options& options, size_t size)
+{
+    std::vector<int> keys(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        keys[i] = static_cast<int>(2 * i);
+    }
+    BenchmarkLookup<FlatSetOps<SortedLayout>>(options, size, FlatSet<int>(keys.begin(), keys.end()));
+    BenchmarkLookup<FlatSetOps<EytzingerLayout>>(options, size,
+                                                 FlatSet<int, std::less<int>, EytzingerLayout>(keys.begin(), keys.end()));
+    BenchmarkLookup<StdSetOps>(options, size, std::set<int>(keys.begin(), keys.end()));
+}
+
+struct AosRecordOps
+{
+    static constexpr std::string_view name = "SimpleVector";
+    static constexpr std::string_view growth = DoublingGrowth::name;
+};
+
+struct SoaRecordOps
+{
+    static constexpr std::string_view name = "SoaVector";
+    static constexpr std::string_view growth = DoublingGrowth::name;
+};
+
+using RecordColumns = SoaVector<int, int, double, long long, std::array<char, 40>>;
+
+// Заполнение и проход по одному (price) и двум (price * quantity) полям записей:
+// SimpleVector<Record> (массив структур) против SoaVector (структура массивов)
+void BenchmarkRecords(const Options& options, size_t size)
+{
+    Measure<AosRecordOps, Record>(options, "push_back", size, [&](Stopwatch& stopwatch)
+        {
+            SimpleVector<Record> v;
+            for (size_t i = 0; i < size; ++i)
+            {
+                v.PushBack(Record{ static_cast<int>(i), static_cast<int>(i % 7), static_cast<double>(i),
+                                   static_cast<long long>(i), {} });
+            }
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + v.GetSize();
+            return size;
+        });
+    Measure<SoaRecordOps, Record>(options, "push_back", size, [&](Stopwatch& stopwatch)
+        {
+            RecordColumns v;
+            for (size_t i = 0; i < size; ++i)
+            {
+                v.PushBack(static_cast<int>(i), static_cast<int>(i % 7), static_cast<double>(i),
+                           static_cast<long long>(i), std::array<char, 40>{});
+            }
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + v.GetSize();
+            return size;
+        });
+
+    SimpleVector<Record> aos(size);
+    RecordColumns soa(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        aos[i].quantity = soa.Column<1>()[i] = static_cast<int>(i % 7);
+        aos[i].price = soa.Column<2>()[i] = static_cast<double>(i);
+    }
+
+    Measure<AosRecordOps, Record>(options, "scan_one_field", size, [&](Stopwatch&)
+        {
+            double total = 0;
+            for (const Record& record : aos)
+            {
+                total += record.price;
+            }
+            benchmark_sink = benchmark_sink + static_cast<size_t>(total);
+            return size;
+        });
+    Measure<SoaRecordOps, Record>(options, "scan_one_field", size, [&](Stopwatch&)
+        {
+            double total = 0;
+            for (double price : soa.Column<2>())
+            {
+                total += price;
+            }
+            benchmark_sink = benchmark_sink + static_cast<size_t>(total);
+            return size;
+        });
+
+    Measure<AosRecordOps, Record>(options, "scan_two_fields", size, [&](Stopwatch&)
+        {
+            double total = 0;
+            for (const Record& record : aos)
+            {
+                total += record.price * record.quantity;
+            }
+            benchmark_sink = benchmark_sink + static_cast<size_t>(total);
+            return size;
+        });
+    Measure<SoaRecordOps, Record>(options, "scan_two_fields", size, [&](Stopwatch&)
+        {
+            const auto quantities = soa.Column<1>();
+            const auto prices = soa.Column<2>();
+            double total = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                total += prices[i] * quantities[i];
+            }
+            benchmark_sink = benchmark_sink + static_cast<size_t>(total);
+            return size;
+        });
+}
+
+// std::allocator, считающий обращения к куче, - точка отсчета для PoolAllocator
+size_t counted_heap_allocations = 0;
+
+template <typename Type>
+struct CountingAllocator : std::allocator<Type>
+{
+    template <typename Other>
+    struct rebind
+    {
+        using other = CountingAllocator<Other>;
+    };
+
+    CountingAllocator() noexcept = default;
+
+    template <typename Other>
+    CountingAllocator(const CountingAllocator<Other>&) noexcept
+    {
+    }
+
+    Type* allocate(size_t size)
+    {
+        ++counted_heap_allocations;
+        return std::allocator<Type>::allocate(size);
+    }
+};
+
+struct HeapVectorOps
+{
+    static constexpr std::string_view name = "SimpleVector";
+    static constexpr std::string_view growth = DoublingGrowth::name;
+};
+
+struct PooledVectorOps
+{
+    static constexpr std::string_view name = "SimpleVector+pool";
+    static constexpr std::string_view growth = DoublingGrowth::name;
+};
+
+// Печатает строку heap_allocations: число обращений к системному распределителю за прогон
+template <typename Ops>
+void PrintHeapAllocations(size_t size, size_t allocations)
+{
+    std::cout << Ops::name << ',' << Ops::growth << ",int,heap_allocations," << size << ',' << allocations << ",0,0\n";
+}
+
+// Обработка size запросов: каждый создает несколько короткоживущих векторов емкостью
+// от сотни до нескольких тысяч элементов и разрушает их. С PoolAllocator буферы разрушенных
+// векторов переиспользуются следующими запросами
+template <typename Allocator>
+size_t RunShortLivedVectors(size_t size)
+{
+    size_t total = 0;
+    for (size_t request = 0; request < size; ++request)
+    {
+        const size_t length = 100 + (request * 7919) % 4000;
+        SimpleVector<int, Allocator> ids;
+        SimpleVector<int, Allocator> scores;
+        for (size_t i = 0; i < length; ++i)
+        {
+            ids.PushBack(static_cast<int>(i));
+        }
+        scores.Resize(length / 2);
+        total += ids.GetSize() + scores.GetSize();
+    }
+    return total;
+}
+
+void BenchmarkBufferPool(const Options& options, size_t size)
+{
+    Measure<HeapVectorOps, int>(options, "short_lived", size, [&](Stopwatch&)
+        {
+            benchmark_sink = benchmark_sink + RunShortLivedVectors<CountingAllocator<int>>(size);
+            return size;
+        });
+    counted_heap_allocations = 0;
+    RunShortLivedVectors<CountingAllocator<int>>(size);
+    PrintHeapAllocations<HeapVectorOps>(size, counted_heap_allocations);
+
+    buffer_pool::TrimThreadCache();
+    Measure<PooledVectorOps, int>(options, "short_lived", size, [&](Stopwatch&)
+        {
+            benchmark_sink = benchmark_sink + RunShortLivedVectors<PoolAllocator<int>>(size);
+            return size;
+        });
+    // Прогон с холодным кэшем: считаются и первые выделения блоков каждого класса
+    buffer_pool::TrimThreadCache();
+    const size_t system_before = buffer_pool::GetThreadStats().system_allocations;
+    RunShortLivedVectors<PoolAllocator<int>>(size);
+    PrintHeapAllocations<PooledVectorOps>(size, buffer_pool::GetThreadStats().system_allocations - system_before);
+    buffer_pool::TrimThreadCache();
+}
+
+struct BitVectorOps
+{
+    static constexpr std::string_view name = "BitVector";
+    static constexpr std::string_view growth = DoublingGrowth::name;
+};
+
+// Битовые карты: подсчет, обход установленных битов, AND и сравнение в BitVector
+// (64 значения на слово) против SimpleVector<bool> (байт на значение)
+void BenchmarkBitmaps(const Options& options, size_t size)
+{
+    using BoolOps = SimpleVectorOps<bool>;
+    SimpleVector<bool> bytes_a(size);
+    SimpleVector<bool> bytes_b(size);
+    BitVector<> bits_a(size);
+    BitVector<> bits_b(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        bytes_a[i] = bits_a[i] = i % 3 == 0;
+        bytes_b[i] = bits_b[i] = i % 5 == 0;
+    }
+
+    Measure<BoolOps, bool>(options, "count", size, [&](Stopwatch&)
+        {
+            benchmark_sink = benchmark_sink + static_cast<size_t>(std::count(bytes_a.begin(), bytes_a.end(), true));
+            return size;
+        });
+    Measure<BitVectorOps, bool>(options, "count", size, [&](Stopwatch&)
+        {
+            benchmark_sink = benchmark_sink + bits_a.Count();
+            return size;
+        });
+
+    Measure<BoolOps, bool>(options, "find_next", size, [&](Stopwatch&)
+        {
+            size_t visited = 0;
+            for (auto it = std::find(bytes_b.begin(), bytes_b.end(), true); it != bytes_b.end();
+                 it = std::find(it + 1, bytes_b.end(), true))
+            {
+                ++visited;
+            }
+            benchmark_sink = benchmark_sink + visited;
+            return size;
+        });
+    Measure<BitVectorOps, bool>(options, "find_next", size, [&](Stopwatch&)
+        {
+            size_t visited = 0;
+            for (size_t i = bits_b.FindFirst(); i != BitVector<>::npos; i = bits_b.FindNext(i))
+            {
+                ++visited;
+            }
+            benchmark_sink = benchmark_sink + visited;
+            return size;
+        });
+
+    Measure<BoolOps, bool>(options, "for_each_set", size, [&](Stopwatch&)
+        {
+            size_t visited = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (bytes_b[i])
+                {
+                    visited += i;
+                }
+            }
+            benchmark_sink = benchmark_sink + visited;
+            return size;
+        });
+    Measure<BitVectorOps, bool>(options, "for_each_set", size, [&](Stopwatch&)
+        {
+            size_t visited = 0;
+            bits_b.ForEachSetBit([&visited](size_t i)
+                {
+                    visited += i;
+                });
+            benchmark_sink = benchmark_sink + visited;
+            return size;
+        });
+
+    Measure<BoolOps, bool>(options, "and", size, [&](Stopwatch& stopwatch)
+        {
+            SimpleVector<bool> result(bytes_a);
+            stopwatch.Restart();
+            for (size_t i = 0; i < size; ++i)
+            {
+                result[i] = result[i] && bytes_b[i];
+            }
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + result.GetSize();
+            return size;
+        });
+    Measure<BitVectorOps, bool>(options, "and", size, [&](Stopwatch& stopwatch)
+        {
+            BitVector<> result(bits_a);
+            stopwatch.Restart();
+            result &= bits_b;
+            stopwatch.Stop();
+            benchmark_sink = benchmark_sink + result.GetSize();
+            return size;
+        });
+
+    const SimpleVector<bool> bytes_copy(bytes_a);
+    const BitVector<> bits_copy(bits_a);
+    Measure<BoolOps, bool>(options, "compare_equal", size, [&](Stopwatch&)
+        {
+            benchmark_sink = benchmark_sink + static_cast<size_t>(bytes_a == bytes_copy);
+            return size;
+        });
+    Measure<BitVectorOps, bool>(options, "compare_equal", size, [&](Stopwatch&)
+        {
+            benchmark_sink = benchmark_sink + static_cast<size_t>(bits_a == bits_copy);
+            return size;
+        });
+}
+
+template <typename Type>
+void BenchmarkType(const Options& options)
+{
+    for (size_t size = options.min_size; size <= options.max_size; size *= 10)
+    {
+        BenchmarkContainer<SimpleVectorOps<Type>, Type>(options, size);
+        if constexpr (std::is_copy_constructible_v<Type>)
+        {
+            BenchmarkParallel<Type>(options, size);
+            BenchmarkSnapshot<Type>(options, size);
+        }
+        BenchmarkGrowth<SimpleVectorOps<Type, OneAndHalfGrowth>, Type>(options, size);
+        BenchmarkGrowth<SimpleVectorOps<Type, SizeClassGrowth<>>, Type>(options, size);
+        BenchmarkGrowth<SimpleVectorOps<Type, PageGrowth<>>, Type>(options, size);
+        BenchmarkGrowth<SegmentedSimpleVectorOps<Type>, Type>(options, size);
+        BenchmarkWorstPushBack<SimpleVectorOps<Type>, Type>(options, size);
+        BenchmarkWorstPushBack<SegmentedSimpleVectorOps<Type>, Type>(options, size);
+        BenchmarkGrowth<IncrementalSimpleVectorOps<Type>, Type>(options, size);
+        BenchmarkWorstPushBack<IncrementalSimpleVectorOps<Type>, Type>(options, size);
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            // Рост через mremap без копирования
+            BenchmarkGrowth<SimpleVectorOps<Type, DoublingGrowth, MmapAllocator<Type>>, Type>(options, size);
+        }
+        BenchmarkContainer<StdVectorOps<Type>, Type>(options, size);
+        if (size > options.max_size / 10)
+        {
+            break;
+        }
+    }
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for "sv << arg << '\n';
+            return false;
+        }
+        const size_t value = std::strtoull(argv[++i], nullptr, 10);
+        if (arg == "--min-size"sv)
+        {
+            options.min_size = value;
+        }
+        else if (arg == "--max-size"sv)
+        {
+            options.max_size = value;
+        }
+        else if (arg == "--repeat"sv)
+        {
+            options.repeat = value;
+        }
+        else
+        {
+            std::cerr << "Unknown option "sv << arg << '\n';
+            return false;
+        }
+    }
+    return options.min_size > 0 && options.repeat > 0 && options.min_size <= options.max_size;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::cerr << "Usage: "sv << argv[0] << " [--min-size N] [--max-size N] [--repeat R]\n"sv;
+        return 1;
+    }
+
+    std::cout << "container,growth,element,operation,size,iterations,total_ns,ns_per_op\n"sv;
+    BenchmarkType<int>(options);
+    for (size_t size = options.min_size; size <= options.max_size; size *= 10)
+    {
+        BenchmarkConcurrentAppend(options, size);
+        BenchmarkFlatSet(options, size);
+        BenchmarkRecords(options, size);
+        BenchmarkBufferPool(options, size);
+        BenchmarkBitmaps(options, size);
+        if (size > options.max_size / 10)
+        {
+            break;
+        }
+    }
+    BenchmarkType<std::string>(options);
+    BenchmarkType<X>(options);
+    return 0;
+}
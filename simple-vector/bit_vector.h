@@ -0,0 +1,637 @@
+#pragma once
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+// Вектор логических значений, упакованных по одному биту в 64-битные слова (в 8 раз меньше
+// памяти, чем SimpleVector<bool>). Слова хранятся в SimpleVector и растут по его политике.
+// Count, FindFirst/FindNext, побитовые операции и сравнение обрабатывают по 64 значения за шаг
+// (popcount, поиск младшего установленного бита). Биты последнего слова за концом вектора
+// всегда нулевые, поэтому слова можно сравнивать и подсчитывать целиком.
+// operator[] возвращает прокси Reference; Insert и Erase сдвигают хвост словами, а не по биту
+template <typename Allocator = std::allocator<uint64_t>>
+class BitVector
+{
+    using Word = uint64_t;
+    using Words = SimpleVector<Word, Allocator>;
+
+    static constexpr size_t WORD_BITS = 64;
+
+public:
+    // Результат FindFirst/FindNext, если установленных битов больше нет
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Ссылка на бит: преобразуется в bool, присваивание меняет бит в слове
+    class Reference
+    {
+    public:
+        Reference(Word& word, Word mask) noexcept : word_(&word), mask_(mask)
+        {
+        }
+
+        Reference(const Reference&) noexcept = default;
+
+        Reference& operator=(bool value) noexcept
+        {
+            *word_ = value ? (*word_ | mask_) : (*word_ & ~mask_);
+            return *this;
+        }
+
+        Reference& operator=(const Reference& other) noexcept
+        {
+            return *this = static_cast<bool>(other);
+        }
+
+        operator bool() const noexcept
+        {
+            return (*word_ & mask_) != 0;
+        }
+
+        void Flip() noexcept
+        {
+            *word_ ^= mask_;
+        }
+
+    private:
+        Word* word_;
+        Word mask_;
+    };
+
+    // Итератор по значениям битов (только чтение)
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = bool;
+
+        ConstIterator() noexcept = default;
+
+        ConstIterator(const BitVector* bits, size_t index) noexcept : bits_(bits), index_(index)
+        {
+        }
+
+        bool operator*() const noexcept
+        {
+            return (*bits_)[index_];
+        }
+
+        bool operator[](difference_type offset) const noexcept
+        {
+            return *(*this + offset);
+        }
+
+        ConstIterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept
+        {
+            ConstIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        ConstIterator& operator--() noexcept
+        {
+            --index_;
+            return *this;
+        }
+
+        ConstIterator operator--(int) noexcept
+        {
+            ConstIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        ConstIterator& operator+=(difference_type offset) noexcept
+        {
+            index_ = static_cast<size_t>(static_cast<difference_type>(index_) + offset);
+            return *this;
+        }
+
+        ConstIterator& operator-=(difference_type offset) noexcept
+        {
+            return *this += -offset;
+        }
+
+        friend ConstIterator operator+(ConstIterator it, difference_type offset) noexcept
+        {
+            return it += offset;
+        }
+
+        friend ConstIterator operator+(difference_type offset, ConstIterator it) noexcept
+        {
+            return it += offset;
+        }
+
+        friend ConstIterator operator-(ConstIterator it, difference_type offset) noexcept
+        {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const ConstIterator& lhs, const ConstIterator& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const ConstIterator& lhs, const ConstIterator& rhs) noexcept
+        {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const ConstIterator& lhs, const ConstIterator& rhs) noexcept
+        {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator<=(const ConstIterator& lhs, const ConstIterator& rhs) noexcept
+        {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>(const ConstIterator& lhs, const ConstIterator& rhs) noexcept
+        {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator>=(const ConstIterator& lhs, const ConstIterator& rhs) noexcept
+        {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        const BitVector* bits_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    BitVector() noexcept = default;
+
+    explicit BitVector(const Allocator& alloc) noexcept : words_(alloc)
+    {
+    }
+
+    // Создает вектор из size битов со значением value
+    explicit BitVector(size_t size, bool value = false, const Allocator& alloc = Allocator())
+        : words_(WordCount(size), value ? ~Word{ 0 } : Word{ 0 }, alloc), size_(size)
+    {
+        ClearTail();
+    }
+
+    BitVector(std::initializer_list<bool> init, const Allocator& alloc = Allocator()) : words_(alloc)
+    {
+        Reserve(init.size());
+        for (bool value : init)
+        {
+            PushBack(value);
+        }
+    }
+
+    BitVector(const BitVector& other) = default;
+    BitVector& operator=(const BitVector& rhs) = default;
+
+    BitVector(BitVector&& other) noexcept : words_(std::move(other.words_)), size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    BitVector& operator=(BitVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            words_ = std::move(rhs.words_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    Allocator GetAllocator() const noexcept
+    {
+        return words_.GetAllocator();
+    }
+
+    // Количество битов
+    size_t GetSize() const noexcept
+    {
+        return size_;
+    }
+
+    // Количество битов, которые поместятся без перевыделения памяти
+    size_t GetCapacity() const noexcept
+    {
+        return words_.GetCapacity() * WORD_BITS;
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // Слова с битами: бит i - бит (i % 64) слова i / 64
+    SimpleVectorView<const Word> GetWords() const noexcept
+    {
+        return words_;
+    }
+
+    Reference operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        return Reference(words_[index / WORD_BITS], Mask(index));
+    }
+
+    bool operator[](size_t index) const noexcept
+    {
+        assert(index < size_);
+        return (words_[index / WORD_BITS] & Mask(index)) != 0;
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Reference At(size_t index)
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator At())");
+        }
+        return (*this)[index];
+    }
+
+    bool At(size_t index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator const At())");
+        }
+        return (*this)[index];
+    }
+
+    void Set(size_t index, bool value = true) noexcept
+    {
+        (*this)[index] = value;
+    }
+
+    void Reset(size_t index) noexcept
+    {
+        (*this)[index] = false;
+    }
+
+    void Flip(size_t index) noexcept
+    {
+        (*this)[index].Flip();
+    }
+
+    // Инвертирует все биты
+    void Flip() noexcept
+    {
+        for (Word& word : words_)
+        {
+            word = ~word;
+        }
+        ClearTail();
+    }
+
+    // Присваивает всем битам значение value
+    void Fill(bool value)
+    {
+        words_.Fill(value ? ~Word{ 0 } : Word{ 0 });
+        ClearTail();
+    }
+
+    void Reserve(size_t capacity)
+    {
+        words_.Reserve(WordCount(capacity));
+    }
+
+    void Clear() noexcept
+    {
+        words_.Clear();
+        size_ = 0;
+    }
+
+    // Изменяет количество битов, новые биты получают значение value
+    void Resize(size_t new_size, bool value = false)
+    {
+        if (new_size > size_ && value)
+        {
+            // Хвост текущего последнего слова заполняется единицами, новые слова - целиком
+            const size_t old_words = words_.GetSize();
+            if (size_ % WORD_BITS != 0)
+            {
+                words_[old_words - 1] |= ~Word{ 0 } << (size_ % WORD_BITS);
+            }
+            words_.Resize(WordCount(new_size));
+            std::fill(words_.begin() + old_words, words_.end(), ~Word{ 0 });
+        }
+        else
+        {
+            words_.Resize(WordCount(new_size));
+        }
+        size_ = new_size;
+        ClearTail();
+    }
+
+    void PushBack(bool value)
+    {
+        if (size_ % WORD_BITS == 0)
+        {
+            words_.PushBack(value ? Word{ 1 } : Word{ 0 });
+        }
+        else if (value)
+        {
+            words_[size_ / WORD_BITS] |= Mask(size_);
+        }
+        ++size_;
+    }
+
+    void PopBack() noexcept
+    {
+        assert(size_ > 0);
+        --size_;
+        if (size_ % WORD_BITS == 0)
+        {
+            words_.PopBack();
+        }
+        else
+        {
+            words_[size_ / WORD_BITS] &= ~Mask(size_);
+        }
+    }
+
+    // Вставляет бит value в позицию index (0 <= index <= size): биты [index, size) сдвигаются
+    // на одну позицию вверх, перенос между словами - старшим битом предыдущего слова
+    void Insert(size_t index, bool value)
+    {
+        assert(index <= size_);
+        PushBack(false);
+        const size_t first_word = index / WORD_BITS;
+        for (size_t i = words_.GetSize() - 1; i > first_word; --i)
+        {
+            words_[i] = (words_[i] << 1) | (words_[i - 1] >> (WORD_BITS - 1));
+        }
+        const Word low_mask = Mask(index) - 1;
+        Word& word = words_[first_word];
+        word = (word & low_mask) | ((word & ~low_mask) << 1);
+        ClearTail();
+        (*this)[index] = value;
+    }
+
+    // Удаляет бит index
+    void Erase(size_t index)
+    {
+        assert(index < size_);
+        Erase(index, index + 1);
+    }
+
+    // Удаляет биты [first, last): хвост копируется вниз кусками до границы слова назначения
+    void Erase(size_t first, size_t last)
+    {
+        assert(first <= last && last <= size_);
+        if (first == last)
+        {
+            return;
+        }
+        size_t dest = first;
+        for (size_t source = last; source < size_;)
+        {
+            const size_t count = std::min(WORD_BITS - dest % WORD_BITS, size_ - source);
+            WriteBits(dest, count, ReadBits(source, count));
+            dest += count;
+            source += count;
+        }
+        size_ -= last - first;
+        words_.Resize(WordCount(size_));
+        ClearTail();
+    }
+
+    // Количество установленных битов
+    size_t Count() const noexcept
+    {
+        size_t count = 0;
+        for (Word word : words_)
+        {
+            count += static_cast<size_t>(__builtin_popcountll(word));
+        }
+        return count;
+    }
+
+    bool Any() const noexcept
+    {
+        return FindFrom(0) != npos;
+    }
+
+    bool None() const noexcept
+    {
+        return !Any();
+    }
+
+    bool All() const noexcept
+    {
+        return Count() == size_;
+    }
+
+    // Номер первого установленного бита или npos
+    size_t FindFirst() const noexcept
+    {
+        return FindFrom(0);
+    }
+
+    // Номер первого установленного бита после index или npos
+    size_t FindNext(size_t index) const noexcept
+    {
+        return index + 1 < size_ ? FindFrom(index + 1) : npos;
+    }
+
+    // Вызывает visit(index) для каждого установленного бита по возрастанию номеров. Быстрее цикла
+    // FindFirst/FindNext на плотных картах: слово читается один раз, младший бит снимается w & (w - 1),
+    // и соседние вызовы не ждут результата друг друга
+    template <typename Visitor>
+    void ForEachSetBit(Visitor visit) const
+    {
+        for (size_t word = 0; word < words_.GetSize(); ++word)
+        {
+            for (Word bits = words_[word]; bits != 0; bits &= bits - 1)
+            {
+                visit(word * WORD_BITS + static_cast<size_t>(__builtin_ctzll(bits)));
+            }
+        }
+    }
+
+    // Побитовые операции с вектором того же размера
+    BitVector& operator&=(const BitVector& other) noexcept
+    {
+        assert(size_ == other.size_);
+        for (size_t i = 0; i < words_.GetSize(); ++i)
+        {
+            words_[i] &= other.words_[i];
+        }
+        return *this;
+    }
+
+    BitVector& operator|=(const BitVector& other) noexcept
+    {
+        assert(size_ == other.size_);
+        for (size_t i = 0; i < words_.GetSize(); ++i)
+        {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
+
+    BitVector& operator^=(const BitVector& other) noexcept
+    {
+        assert(size_ == other.size_);
+        for (size_t i = 0; i < words_.GetSize(); ++i)
+        {
+            words_[i] ^= other.words_[i];
+        }
+        return *this;
+    }
+
+    void swap(BitVector& other) noexcept
+    {
+        words_.swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+private:
+    Words words_;
+    size_t size_ = 0;
+
+    static size_t WordCount(size_t bits) noexcept
+    {
+        return (bits + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    static Word Mask(size_t index) noexcept
+    {
+        return Word{ 1 } << (index % WORD_BITS);
+    }
+
+    // Маска младших count битов (count <= 64)
+    static Word LowBits(size_t count) noexcept
+    {
+        return count == WORD_BITS ? ~Word{ 0 } : (Word{ 1 } << count) - 1;
+    }
+
+    // Обнуляет биты последнего слова за концом вектора
+    void ClearTail() noexcept
+    {
+        if (size_ % WORD_BITS != 0)
+        {
+            words_[words_.GetSize() - 1] &= LowBits(size_ % WORD_BITS);
+        }
+    }
+
+    // count (<= 64) битов, начиная с бита position, в младших битах результата
+    Word ReadBits(size_t position, size_t count) const noexcept
+    {
+        const size_t word = position / WORD_BITS;
+        const size_t offset = position % WORD_BITS;
+        Word bits = words_[word] >> offset;
+        if (offset + count > WORD_BITS)
+        {
+            bits |= words_[word + 1] << (WORD_BITS - offset);
+        }
+        return bits & LowBits(count);
+    }
+
+    // Записывает младшие count битов bits в биты [position, position + count) одного слова
+    void WriteBits(size_t position, size_t count, Word bits) noexcept
+    {
+        const size_t offset = position % WORD_BITS;
+        assert(offset + count <= WORD_BITS);
+        const Word mask = LowBits(count) << offset;
+        Word& word = words_[position / WORD_BITS];
+        word = (word & ~mask) | ((bits << offset) & mask);
+    }
+
+    // Номер первого установленного бита, не меньшего start, или npos
+    size_t FindFrom(size_t start) const noexcept
+    {
+        size_t word = start / WORD_BITS;
+        if (word >= words_.GetSize())
+        {
+            return npos;
+        }
+        Word bits = words_[word] & (~Word{ 0 } << (start % WORD_BITS));
+        while (bits == 0)
+        {
+            if (++word == words_.GetSize())
+            {
+                return npos;
+            }
+            bits = words_[word];
+        }
+        return word * WORD_BITS + static_cast<size_t>(__builtin_ctzll(bits));
+    }
+};
+
+// Сравнение словами: биты за концом нулевые, поэтому равные векторы имеют равные слова
+template <typename Allocator>
+inline bool operator==(const BitVector<Allocator>& lhs, const BitVector<Allocator>& rhs)
+{
+    return lhs.GetSize() == rhs.GetSize() && lhs.GetWords() == rhs.GetWords();
+}
+
+template <typename Allocator>
+inline bool operator!=(const BitVector<Allocator>& lhs, const BitVector<Allocator>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Allocator>
+inline BitVector<Allocator> operator&(BitVector<Allocator> lhs, const BitVector<Allocator>& rhs)
+{
+    lhs &= rhs;
+    return lhs;
+}
+
+template <typename Allocator>
+inline BitVector<Allocator> operator|(BitVector<Allocator> lhs, const BitVector<Allocator>& rhs)
+{
+    lhs |= rhs;
+    return lhs;
+}
+
+template <typename Allocator>
+inline BitVector<Allocator> operator^(BitVector<Allocator> lhs, const BitVector<Allocator>& rhs)
+{
+    lhs ^= rhs;
+    return lhs;
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "array_ptr.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Вектор для одновременного добавления элементов из многих потоков.
+// Элементы хранятся в корзинах, размеры которых растут вдвое: корзина b вмещает FIRST_BUCKET_SIZE << b
+// элементов, поэтому индекс переводится в (корзина, смещение) парой битовых операций.
+// Корзины никогда не перевыделяются, так что добавленные элементы не перемещаются, а ссылки
+// и указатели на них остаются действительными до разрушения вектора.
+// PushBack/EmplaceBack занимают индекс атомарным fetch_add (без блокировок); отсутствующую корзину
+// поток выделяет сам и устанавливает через compare_exchange, проигравший освобождает свою.
+// Элемент становится видимым читателям (IsPublished/TryGet) только после завершения конструирования.
+// Разрушение вектора не должно пересекаться с другими операциями над ним
+template <typename Type, typename Allocator = std::allocator<Type>>
+class ConcurrentSimpleVector
+{
+public:
+    static constexpr size_t FIRST_BUCKET_SIZE = 8;
+
+    ConcurrentSimpleVector() noexcept = default;
+
+    explicit ConcurrentSimpleVector(const Allocator& alloc) noexcept : alloc_(alloc)
+    {
+    }
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector()
+    {
+        for (std::atomic<Bucket*>& slot : buckets_)
+        {
+            delete slot.load(std::memory_order_acquire);
+        }
+    }
+
+    // Добавляет копию item и возвращает ее индекс. Безопасно вызывается из разных потоков
+    size_t PushBack(const Type& item)
+    {
+        return EmplaceBack(item);
+    }
+
+    size_t PushBack(Type&& item)
+    {
+        return EmplaceBack(std::move(item));
+    }
+
+    // Конструирует элемент из args и возвращает его индекс. Безопасно вызывается из разных потоков.
+    // Если конструктор выбросит исключение, индекс останется занятым, но не опубликованным
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args)
+    {
+        const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+        const Location location = Locate(index);
+        Bucket& bucket = GetOrCreateBucket(location.bucket);
+        bucket.items.Construct(bucket.items.Get() + location.offset, std::forward<Args>(args)...);
+        bucket.published[location.offset].store(true, std::memory_order_release);
+        return index;
+    }
+
+    // Заранее выделяет корзины для индексов [0, capacity)
+    void Reserve(size_t capacity)
+    {
+        if (capacity == 0)
+        {
+            return;
+        }
+        const size_t last_bucket = Locate(capacity - 1).bucket;
+        for (size_t bucket = 0; bucket <= last_bucket; ++bucket)
+        {
+            GetOrCreateBucket(bucket);
+        }
+    }
+
+    // Количество занятых индексов. Элементы с последними из них могут еще конструироваться
+    size_t GetSize() const noexcept
+    {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return GetSize() == 0;
+    }
+
+    // Сообщает, сконструирован ли элемент с индексом index. После true элемент можно читать
+    bool IsPublished(size_t index) const noexcept
+    {
+        if (index >= GetSize())
+        {
+            return false;
+        }
+        const Location location = Locate(index);
+        const Bucket* bucket = buckets_[location.bucket].load(std::memory_order_acquire);
+        return bucket != nullptr && bucket->published[location.offset].load(std::memory_order_acquire);
+    }
+
+    // Указатель на опубликованный элемент или nullptr, если элемент еще не готов
+    Type* TryGet(size_t index) noexcept
+    {
+        return IsPublished(index) ? &ElementAt(index) : nullptr;
+    }
+
+    const Type* TryGet(size_t index) const noexcept
+    {
+        return IsPublished(index) ? &ElementAt(index) : nullptr;
+    }
+
+    // Доступ к элементу, опубликованность которого уже установлена: через IsPublished/TryGet
+    // или завершением (join) добавлявших потоков
+    Type& operator[](size_t index) noexcept
+    {
+        assert(IsPublished(index));
+        return ElementAt(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept
+    {
+        assert(IsPublished(index));
+        return ElementAt(index);
+    }
+
+    // Вызывает callback(index, item) для каждого опубликованного элемента в порядке индексов
+    template <typename Callback>
+    void ForEachPublished(Callback callback) const
+    {
+        const size_t size = GetSize();
+        for (size_t index = 0; index < size; ++index)
+        {
+            if (const Type* item = TryGet(index))
+            {
+                callback(index, *item);
+            }
+        }
+    }
+
+    Allocator GetAllocator() const noexcept
+    {
+        return alloc_;
+    }
+
+private:
+    using FlagAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::atomic<bool>>;
+
+    // Корзина: элементы и признаки их готовности
+    struct Bucket
+    {
+        ArrayPtr<Type, Allocator> items;
+        ArrayPtr<std::atomic<bool>, FlagAllocator> published;
+
+        Bucket(size_t size, const Allocator& alloc)
+            : items(size, alloc), published(size, FlagAllocator(alloc))
+        {
+            published.UninitializedValueConstruct(published.Get(), published.Get() + size);
+        }
+
+        ~Bucket()
+        {
+            for (size_t i = 0; i < items.GetSize(); ++i)
+            {
+                if (published[i].load(std::memory_order_relaxed))
+                {
+                    items.Destroy(items.Get() + i, items.Get() + i + 1);
+                }
+            }
+        }
+    };
+
+    struct Location
+    {
+        size_t bucket;
+        size_t offset;
+    };
+
+    static constexpr size_t FIRST_BUCKET_BITS = 3;
+    static_assert(FIRST_BUCKET_SIZE == size_t{ 1 } << FIRST_BUCKET_BITS);
+    static constexpr size_t MAX_BUCKETS = sizeof(size_t) * 8 - FIRST_BUCKET_BITS;
+
+    std::atomic<size_t> size_{ 0 };
+    std::atomic<Bucket*> buckets_[MAX_BUCKETS] = {};
+    Allocator alloc_;
+
+    // Корзина b хранит индексы [F * (2^b - 1), F * (2^(b+1) - 1)), где F = FIRST_BUCKET_SIZE
+    static Location Locate(size_t index) noexcept
+    {
+        const size_t biased = index + FIRST_BUCKET_SIZE;
+        const size_t high_bit = sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(biased));
+        return { high_bit - FIRST_BUCKET_BITS, biased ^ (size_t{ 1 } << high_bit) };
+    }
+
+    static size_t BucketSize(size_t bucket) noexcept
+    {
+        return FIRST_BUCKET_SIZE << bucket;
+    }
+
+    Type& ElementAt(size_t index) const noexcept
+    {
+        const Location location = Locate(index);
+        return buckets_[location.bucket].load(std::memory_order_acquire)->items[location.offset];
+    }
+
+    Bucket& GetOrCreateBucket(size_t index)
+    {
+        Bucket* bucket = buckets_[index].load(std::memory_order_acquire);
+        if (bucket != nullptr)
+        {
+            return *bucket;
+        }
+        auto created = std::make_unique<Bucket>(BucketSize(index), alloc_);
+        if (buckets_[index].compare_exchange_strong(bucket, created.get(), std::memory_order_acq_rel,
+                                                    std::memory_order_acquire))
+        {
+            return *created.release();
+        }
+        // Корзину уже установил другой поток: bucket указывает на нее
+        return *bucket;
+    }
+};
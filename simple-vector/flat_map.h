@@ -0,0 +1,568 @@
+#pragma once
+#include "flat_search.h"
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Упорядоченный словарь на двух SimpleVector: отсортированные ключи и значения в том же порядке.
+// Поиск проходит только по массиву ключей (значения не занимают строк кэша), итерация - по обоим.
+// Вставка и удаление одного элемента сдвигают хвосты (O(n)), поэтому словарь лучше заполнять
+// пакетно через InsertRange. Layout задает раскладку поиска по ключам (см. flat_search.h).
+// Разыменование итератора дает пару ссылок std::pair<const Key&, Value&>, поэтому
+//     for (auto [key, value] : map) { value = ...; }
+// изменяет значения в словаре. Итераторы становятся недействительными после вставки и удаления
+template <typename Key, typename Value, typename Compare = std::less<Key>, typename Layout = SortedLayout,
+          typename KeyAllocator = std::allocator<Key>, typename ValueAllocator = std::allocator<Value>>
+class FlatMap
+{
+    using Keys = SimpleVector<Key, KeyAllocator>;
+    using Values = SimpleVector<Value, ValueAllocator>;
+    using Index = typename Layout::template Index<Key, KeyAllocator>;
+
+    // Итератор по позициям словаря
+    template <bool IsConst>
+    class BasicIterator
+    {
+        using Map = std::conditional_t<IsConst, const FlatMap, FlatMap>;
+        using ValueReference = std::conditional_t<IsConst, const Value&, Value&>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, ValueReference>;
+
+        // Указатель на временную пару ссылок для operator->
+        class pointer
+        {
+        public:
+            explicit pointer(reference ref) noexcept : ref_(ref)
+            {
+            }
+
+            const reference* operator->() const noexcept
+            {
+                return &ref_;
+            }
+
+        private:
+            reference ref_;
+        };
+
+        BasicIterator() noexcept = default;
+
+        // Константный итератор из неконстантного
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept : map_(other.map_), index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return { map_->keys_[index_], map_->values_[index_] };
+        }
+
+        pointer operator->() const noexcept
+        {
+            return pointer(**this);
+        }
+
+        reference operator[](difference_type offset) const noexcept
+        {
+            return *(*this + offset);
+        }
+
+        const Key& GetKey() const noexcept
+        {
+            return map_->keys_[index_];
+        }
+
+        ValueReference GetValue() const noexcept
+        {
+            return map_->values_[index_];
+        }
+
+        // Позиция элемента в словаре
+        size_t GetIndex() const noexcept
+        {
+            return index_;
+        }
+
+        BasicIterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept
+        {
+            BasicIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept
+        {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept
+        {
+            BasicIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept
+        {
+            index_ = static_cast<size_t>(static_cast<difference_type>(index_) + offset);
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept
+        {
+            return *this += -offset;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept
+        {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept
+        {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept
+        {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+    private:
+        friend class FlatMap;
+        friend class BasicIterator<!IsConst>;
+
+        Map* map_ = nullptr;
+        size_t index_ = 0;
+
+        BasicIterator(Map* map, size_t index) noexcept : map_(map), index_(index)
+        {
+        }
+    };
+
+public:
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    FlatMap() : FlatMap(Compare())
+    {
+    }
+
+    explicit FlatMap(const Compare& comp, const KeyAllocator& key_alloc = KeyAllocator(),
+                     const ValueAllocator& value_alloc = ValueAllocator())
+        : keys_(key_alloc), values_(value_alloc), comp_(comp), index_(key_alloc)
+    {
+    }
+
+    // Из пар (ключ, значение) [first, last), см. InsertRange
+    template <typename InputIt>
+    FlatMap(InputIt first, InputIt last, const Compare& comp = Compare())
+        : FlatMap(comp)
+    {
+        InsertRange(first, last);
+    }
+
+    FlatMap(std::initializer_list<std::pair<Key, Value>> init, const Compare& comp = Compare())
+        : FlatMap(init.begin(), init.end(), comp)
+    {
+    }
+
+    // Отсортированные ключи без повторов
+    const Keys& GetKeys() const noexcept
+    {
+        return keys_;
+    }
+
+    // Значения в порядке ключей
+    const Values& GetValues() const noexcept
+    {
+        return values_;
+    }
+
+    size_t GetSize() const noexcept
+    {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return keys_.IsEmpty();
+    }
+
+    void Reserve(size_t capacity)
+    {
+        keys_.Reserve(capacity);
+        values_.Reserve(capacity);
+    }
+
+    void Clear()
+    {
+        keys_.Clear();
+        values_.Clear();
+        RebuildIndex();
+    }
+
+    // Итератор на первый элемент с ключом, не меньшим key
+    Iterator LowerBound(const Key& key)
+    {
+        return Iterator(this, LowerBoundIndex(key));
+    }
+
+    ConstIterator LowerBound(const Key& key) const
+    {
+        return ConstIterator(this, LowerBoundIndex(key));
+    }
+
+    // Итератор на первый элемент с ключом, большим key
+    Iterator UpperBound(const Key& key)
+    {
+        return Iterator(this, UpperBoundIndex(key));
+    }
+
+    ConstIterator UpperBound(const Key& key) const
+    {
+        return ConstIterator(this, UpperBoundIndex(key));
+    }
+
+    // Итератор на элемент с ключом key или end()
+    Iterator Find(const Key& key)
+    {
+        return Iterator(this, FindIndex(key));
+    }
+
+    ConstIterator Find(const Key& key) const
+    {
+        return ConstIterator(this, FindIndex(key));
+    }
+
+    bool Contains(const Key& key) const
+    {
+        return FindIndex(key) != GetSize();
+    }
+
+    size_t Count(const Key& key) const
+    {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Выбрасывает исключение std::out_of_range, если ключа нет
+    Value& At(const Key& key)
+    {
+        const size_t index = FindIndex(key);
+        if (index == GetSize())
+        {
+            throw std::out_of_range("Key is not found (operator At())");
+        }
+        return values_[index];
+    }
+
+    const Value& At(const Key& key) const
+    {
+        const size_t index = FindIndex(key);
+        if (index == GetSize())
+        {
+            throw std::out_of_range("Key is not found (operator const At())");
+        }
+        return values_[index];
+    }
+
+    // Значение по ключу key; при отсутствии ключа вставляет значение по умолчанию
+    Value& operator[](const Key& key)
+    {
+        return TryEmplace(key).first.GetValue();
+    }
+
+    // Вставляет значение, сконструированное из args, если ключа key нет.
+    // Возвращает итератор на элемент и признак вставки
+    template <typename KeyArg, typename... Args>
+    std::pair<Iterator, bool> TryEmplace(KeyArg&& key, Args&&... args)
+    {
+        const size_t index = LowerBoundIndex(key);
+        if (index != GetSize() && !comp_(key, keys_[index]))
+        {
+            return { Iterator(this, index), false };
+        }
+        // Значение создается до вставки ключа: при исключении словарь не изменится
+        Value value(std::forward<Args>(args)...);
+        keys_.Insert(keys_.cbegin() + index, std::forward<KeyArg>(key));
+        try
+        {
+            values_.Insert(values_.cbegin() + index, std::move(value));
+        }
+        catch (...)
+        {
+            keys_.Erase(keys_.cbegin() + index);
+            throw;
+        }
+        RebuildIndex();
+        return { Iterator(this, index), true };
+    }
+
+    // Вставляет пару (ключ, значение), если ключа нет
+    std::pair<Iterator, bool> Insert(const Key& key, const Value& value)
+    {
+        return TryEmplace(key, value);
+    }
+
+    std::pair<Iterator, bool> Insert(Key&& key, Value&& value)
+    {
+        return TryEmplace(std::move(key), std::move(value));
+    }
+
+    // Вставляет пару или присваивает значение существующему ключу. Признак - была ли вставка
+    template <typename ValueArg>
+    std::pair<Iterator, bool> InsertOrAssign(const Key& key, ValueArg&& value)
+    {
+        const size_t index = FindIndex(key);
+        if (index != GetSize())
+        {
+            values_[index] = std::forward<ValueArg>(value);
+            return { Iterator(this, index), false };
+        }
+        return TryEmplace(key, std::forward<ValueArg>(value));
+    }
+
+    // Вставляет пары [first, last) (элементы с полями first и second) за один проход: пары собираются
+    // отдельно, упорядочиваются перестановкой по ключам и сливаются с имеющимися элементами.
+    // Повторы отбрасываются: из равных ключей остается вставленный раньше
+    template <typename InputIt>
+    void InsertRange(InputIt first, InputIt last)
+    {
+        Keys added_keys(keys_.GetAllocator());
+        Values added_values(values_.GetAllocator());
+        for (; first != last; ++first)
+        {
+            added_keys.PushBack(first->first);
+            added_values.PushBack(first->second);
+        }
+
+        // Сортируется перестановка, а не пары: ключи и значения лежат в разных массивах
+        SimpleVector<size_t> order(added_keys.GetSize());
+        for (size_t i = 0; i < order.GetSize(); ++i)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [this, &added_keys](size_t lhs, size_t rhs)
+            {
+                return comp_(added_keys[lhs], added_keys[rhs]);
+            });
+
+        // Старые пары перемещаются, только если перемещение ключа и значения не выбрасывает
+        // исключений; иначе обе копируются, и при ошибке словарь не меняется (перемещенный ключ
+        // без своего значения остался бы в словаре испорченным)
+        constexpr bool move_old = (std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<Value>)
+                                  || !(std::is_copy_constructible_v<Key> && std::is_copy_constructible_v<Value>);
+        Keys merged_keys(keys_.GetAllocator());
+        Values merged_values(values_.GetAllocator());
+        merged_keys.Reserve(keys_.GetSize() + added_keys.GetSize());
+        merged_values.Reserve(keys_.GetSize() + added_keys.GetSize());
+        const auto append = [&merged_keys, &merged_values, this](auto&& key, auto&& value)
+            {
+                if (merged_keys.IsEmpty() || comp_(merged_keys[merged_keys.GetSize() - 1], key))
+                {
+                    merged_keys.PushBack(std::forward<decltype(key)>(key));
+                    merged_values.PushBack(std::forward<decltype(value)>(value));
+                }
+            };
+        size_t old_index = 0;
+        size_t new_index = 0;
+        while (old_index < keys_.GetSize() || new_index < order.GetSize())
+        {
+            if (new_index == order.GetSize()
+                || (old_index < keys_.GetSize() && !comp_(added_keys[order[new_index]], keys_[old_index])))
+            {
+                if constexpr (move_old)
+                {
+                    append(std::move(keys_[old_index]), std::move(values_[old_index]));
+                }
+                else
+                {
+                    append(std::as_const(keys_[old_index]), std::as_const(values_[old_index]));
+                }
+                ++old_index;
+            }
+            else
+            {
+                // Добавленные пары - временные, их можно перемещать всегда
+                append(std::move(added_keys[order[new_index]]), std::move(added_values[order[new_index]]));
+                ++new_index;
+            }
+        }
+        keys_.swap(merged_keys);
+        values_.swap(merged_values);
+        RebuildIndex();
+    }
+
+    template <typename Range>
+    void InsertRange(const Range& range)
+    {
+        InsertRange(std::begin(range), std::end(range));
+    }
+
+    // Удаляет элемент с ключом key. Возвращает количество удаленных элементов (0 или 1)
+    size_t Erase(const Key& key)
+    {
+        const size_t index = FindIndex(key);
+        if (index == GetSize())
+        {
+            return 0;
+        }
+        Erase(ConstIterator(this, index));
+        return 1;
+    }
+
+    // Удаляет элемент в позиции pos и возвращает итератор на следующий
+    Iterator Erase(ConstIterator pos)
+    {
+        assert(pos.map_ == this && pos.index_ < GetSize());
+        keys_.Erase(keys_.cbegin() + pos.index_);
+        values_.Erase(values_.cbegin() + pos.index_);
+        RebuildIndex();
+        return Iterator(this, pos.index_);
+    }
+
+    void swap(FlatMap& other) noexcept
+    {
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        std::swap(comp_, other.comp_);
+        std::swap(index_, other.index_);
+    }
+
+    Iterator begin() noexcept
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(this, GetSize());
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return cbegin();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return cend();
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return ConstIterator(this, GetSize());
+    }
+
+private:
+    Keys keys_;
+    Values values_;
+    Compare comp_;
+    Index index_;
+
+    size_t LowerBoundIndex(const Key& key) const
+    {
+        return index_.LowerBound(keys_.cbegin(), keys_.GetSize(), key, comp_).position;
+    }
+
+    size_t UpperBoundIndex(const Key& key) const
+    {
+        const flat_search::Bound<Key> bound = index_.LowerBound(keys_.cbegin(), keys_.GetSize(), key, comp_);
+        return bound.key != nullptr && !comp_(key, *bound.key) ? bound.position + 1 : bound.position;
+    }
+
+    // Позиция ключа key или GetSize(), если его нет
+    size_t FindIndex(const Key& key) const
+    {
+        const flat_search::Bound<Key> bound = index_.LowerBound(keys_.cbegin(), keys_.GetSize(), key, comp_);
+        return bound.key != nullptr && !comp_(key, *bound.key) ? bound.position : GetSize();
+    }
+
+    // Вызывается после того, как изменение уже применено, поэтому не выбрасывает исключений:
+    // если индекс перестроить не удалось, он помечен недействительным, и поиск идет по keys_
+    void RebuildIndex() noexcept
+    {
+        try
+        {
+            index_.Build(keys_.cbegin(), keys_.GetSize());
+        }
+        catch (...)
+        {
+        }
+    }
+};
+
+template <typename Key, typename Value, typename Compare, typename Layout, typename KeyAllocator, typename ValueAllocator>
+inline bool operator==(const FlatMap<Key, Value, Compare, Layout, KeyAllocator, ValueAllocator>& lhs,
+                       const FlatMap<Key, Value, Compare, Layout, KeyAllocator, ValueAllocator>& rhs)
+{
+    return lhs.GetKeys() == rhs.GetKeys() && lhs.GetValues() == rhs.GetValues();
+}
+
+template <typename Key, typename Value, typename Compare, typename Layout, typename KeyAllocator, typename ValueAllocator>
+inline bool operator!=(const FlatMap<Key, Value, Compare, Layout, KeyAllocator, ValueAllocator>& lhs,
+                       const FlatMap<Key, Value, Compare, Layout, KeyAllocator, ValueAllocator>& rhs)
+{
+    return !(lhs == rhs);
+}
@@ -0,0 +1,166 @@
+#pragma once
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+// Раскладки поиска для FlatSet/FlatMap. Раскладка - класс с вложенным шаблоном
+//     template <typename Key, typename Allocator> class Index
+// с методами Build(sorted, size) (перестроение после изменения отсортированных ключей) и
+// LowerBound(sorted, size, key, comp), возвращающим flat_search::Bound для первого ключа, не меньшего key.
+// Если Build выбросил исключение, контейнер его подавляет (изменение ключей уже применено), поэтому
+// LowerBound после неудачного Build должен оставаться корректным
+
+namespace flat_search
+{
+
+// Позиция найденного ключа в отсортированном массиве (size, если ключа нет) и указатель на ключ
+// (nullptr, если ключа нет). Ключ может лежать в копии ключей раскладки, тогда проверка
+// на равенство не обращается к отсортированному массиву (лишний промах кэша на больших массивах)
+template <typename Key>
+struct Bound
+{
+    size_t position;
+    const Key* key;
+};
+
+// Двоичный поиск без ветвлений: на каждом шаге сравнение выбирает, сдвигать ли основание,
+// и процессор не ошибается в предсказании переходов
+template <typename Key, typename Compare>
+Bound<Key> BranchlessLowerBound(const Key* sorted, size_t size, const Key& key, const Compare& comp)
+{
+    if (size == 0)
+    {
+        return { 0, nullptr };
+    }
+    const Key* base = sorted;
+    size_t count = size;
+    while (count > 1)
+    {
+        const size_t half = count / 2;
+        base = comp(base[half], key) ? base + half : base;
+        count -= half;
+    }
+    const size_t position = static_cast<size_t>(base - sorted) + static_cast<size_t>(comp(*base, key));
+    return { position, position < size ? sorted + position : nullptr };
+}
+
+// Количество значащих битов: 0 для 0, floor(log2(value)) + 1 для остальных
+inline size_t BitWidth(size_t value) noexcept
+{
+    return value == 0 ? 0 : sizeof(unsigned long long) * 8 - static_cast<size_t>(__builtin_clzll(value));
+}
+
+} // namespace flat_search
+
+// Поиск без ветвлений прямо в отсортированном массиве ключей, без дополнительной памяти
+struct SortedLayout
+{
+    static constexpr std::string_view name = "sorted";
+
+    template <typename Key, typename Allocator>
+    class Index
+    {
+    public:
+        explicit Index(const Allocator& /*alloc*/) noexcept
+        {
+        }
+
+        void Build(const Key* /*sorted*/, size_t /*size*/) noexcept
+        {
+        }
+
+        template <typename Compare>
+        flat_search::Bound<Key> LowerBound(const Key* sorted, size_t size, const Key& key, const Compare& comp) const
+        {
+            return flat_search::BranchlessLowerBound(sorted, size, key, comp);
+        }
+    };
+};
+
+// Дополнительная копия ключей в порядке Эйтцингера (обход двоичного дерева поиска в ширину:
+// потомки узла k - узлы 2k и 2k+1). Первые уровни дерева, которые проходит каждый поиск, лежат
+// рядом в нескольких строках кэша, а узлы следующих уровней подгружаются заранее (prefetch).
+// Позиция узла в отсортированном массиве вычисляется по его номеру, так что поиск обращается
+// только к копии. Стоит копии ключей и перестроения за O(n) при каждом изменении, поэтому подходит
+// для таблиц, которые редко меняются и часто читаются. Если перестроить копию не удалось
+// (нехватка памяти), поиск идет по отсортированному массиву до следующего перестроения
+struct EytzingerLayout
+{
+    static constexpr std::string_view name = "eytzinger";
+
+    template <typename Key, typename Allocator>
+    class Index
+    {
+        using KeyAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+
+    public:
+        explicit Index(const Allocator& alloc) : keys_(KeyAllocator(alloc))
+        {
+        }
+
+        void Build(const Key* sorted, size_t size)
+        {
+            valid_ = false;
+            SimpleVector<Key, KeyAllocator> keys(keys_.GetAllocator());
+            keys.Reserve(size);
+            for (size_t node = 1; node <= size; ++node)
+            {
+                keys.PushBack(sorted[Position(node, size)]);
+            }
+            keys_.swap(keys);
+            valid_ = true;
+        }
+
+        template <typename Compare>
+        flat_search::Bound<Key> LowerBound(const Key* sorted, size_t size, const Key& key, const Compare& comp) const
+        {
+            if (!valid_)
+            {
+                return flat_search::BranchlessLowerBound(sorted, size, key, comp);
+            }
+            // Потомки узла k на log2(B) уровней ниже - узлы B*k..B*k+B-1. При B ключах на строку кэша
+            // это одна строка, и она подгружается, пока идут сравнения на промежуточных уровнях
+            constexpr size_t prefetch_distance = std::max<size_t>(64 / sizeof(Key), 1);
+            // Узлы нумеруются с 1: узел node хранится в keys[node - 1]
+            const Key* keys = keys_.cbegin();
+            size_t node = 1;
+            while (node <= size)
+            {
+#if defined(__GNUC__)
+                // Адрес за концом массива допустим: prefetch не обращается к памяти и не вызывает ошибок
+                __builtin_prefetch(keys + (prefetch_distance * node - 1));
+#endif
+                node = 2 * node + static_cast<size_t>(comp(keys[node - 1], key));
+            }
+            // Путь поиска закодирован в битах node: последний поворот налево (бит 0 после серии единиц)
+            // указывает на искомый узел; 0 - все ключи меньше key
+            node >>= __builtin_ffsll(static_cast<long long>(~node));
+            if (node == 0)
+            {
+                return { size, nullptr };
+            }
+            return { Position(node, size), keys + node - 1 };
+        }
+
+    private:
+        SimpleVector<Key, KeyAllocator> keys_;
+        bool valid_ = false;
+
+        // Позиция узла node (1..size) в отсортированном массиве. В полном дереве высоты H узел с номером
+        // j на своем уровне d идет в симметричном порядке (2j + 1) * 2^(H-1-d)-м (счет с 1). На неполном
+        // последнем уровне есть только первые L узлов, их номера - нечетные 1, 3, ..., 2L - 1;
+        // отсутствующие узлы с меньшими номерами вычитаются
+        static size_t Position(size_t node, size_t size) noexcept
+        {
+            const size_t height = flat_search::BitWidth(size);
+            const size_t depth = flat_search::BitWidth(node) - 1;
+            const size_t in_order = (2 * (node - (size_t{ 1 } << depth)) + 1) << (height - 1 - depth);
+            const size_t last_level = size - ((size_t{ 1 } << (height - 1)) - 1);
+            const size_t missing = in_order / 2 > last_level ? in_order / 2 - last_level : 0;
+            return in_order - missing - 1;
+        }
+    };
+};
@@ -0,0 +1,281 @@
+#pragma once
+#include "flat_search.h"
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+// Упорядоченное множество в отсортированном SimpleVector: поиск - двоичный по непрерывному массиву
+// вместо обхода узлов дерева, итерация - проход по массиву. Вставка и удаление одного ключа сдвигают
+// хвост (O(n)), поэтому множество лучше заполнять пакетно через InsertRange.
+// Layout задает раскладку поиска (см. flat_search.h): SortedLayout - поиск прямо в массиве,
+// EytzingerLayout - в дополнительной копии ключей, быстрее на множествах, не помещающихся в кэш.
+// Итераторы и указатели на ключи становятся недействительными после любого изменения
+template <typename Key, typename Compare = std::less<Key>, typename Layout = SortedLayout,
+          typename Allocator = std::allocator<Key>>
+class FlatSet
+{
+    using Keys = SimpleVector<Key, Allocator>;
+    using Index = typename Layout::template Index<Key, Allocator>;
+
+public:
+    using ConstIterator = const Key*;
+    using Iterator = ConstIterator;     // Ключи изменять нельзя: нарушится порядок
+    using AllocatorType = Allocator;
+
+    FlatSet() : FlatSet(Compare())
+    {
+    }
+
+    explicit FlatSet(const Compare& comp, const Allocator& alloc = Allocator())
+        : keys_(alloc), comp_(comp), index_(alloc)
+    {
+    }
+
+    template <typename InputIt>
+    FlatSet(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : FlatSet(comp, alloc)
+    {
+        InsertRange(first, last);
+    }
+
+    FlatSet(std::initializer_list<Key> init, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : FlatSet(init.begin(), init.end(), comp, alloc)
+    {
+    }
+
+    Allocator GetAllocator() const noexcept
+    {
+        return keys_.GetAllocator();
+    }
+
+    // Отсортированные ключи без повторов
+    const Keys& GetKeys() const noexcept
+    {
+        return keys_;
+    }
+
+    size_t GetSize() const noexcept
+    {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return keys_.IsEmpty();
+    }
+
+    void Reserve(size_t capacity)
+    {
+        keys_.Reserve(capacity);
+    }
+
+    void Clear()
+    {
+        keys_.Clear();
+        RebuildIndex();
+    }
+
+    // Итератор на первый ключ, не меньший key
+    ConstIterator LowerBound(const Key& key) const
+    {
+        return cbegin() + Search(key).position;
+    }
+
+    // Итератор на первый ключ, больший key
+    ConstIterator UpperBound(const Key& key) const
+    {
+        const flat_search::Bound<Key> bound = Search(key);
+        return cbegin() + (bound.key != nullptr && !comp_(key, *bound.key) ? bound.position + 1 : bound.position);
+    }
+
+    // Итератор на ключ, равный key, или end()
+    ConstIterator Find(const Key& key) const
+    {
+        const flat_search::Bound<Key> bound = Search(key);
+        return bound.key != nullptr && !comp_(key, *bound.key) ? cbegin() + bound.position : cend();
+    }
+
+    bool Contains(const Key& key) const
+    {
+        return Find(key) != cend();
+    }
+
+    size_t Count(const Key& key) const
+    {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Вставляет key, если его нет. Возвращает итератор на ключ и признак вставки
+    std::pair<ConstIterator, bool> Insert(const Key& key)
+    {
+        return EmplaceAt(LowerBound(key), key);
+    }
+
+    std::pair<ConstIterator, bool> Insert(Key&& key)
+    {
+        return EmplaceAt(LowerBound(key), std::move(key));
+    }
+
+    // Вставляет ключи [first, last) за один проход: они собираются в отдельный вектор, сортируются и
+    // сливаются с уже имеющимися, повторы отбрасываются (из равных ключей остается вставленный раньше).
+    // O(n + m log m) вместо O(n * m) у m отдельных Insert
+    template <typename InputIt>
+    void InsertRange(InputIt first, InputIt last)
+    {
+        Keys added(keys_.GetAllocator());
+        added.Insert(added.cend(), first, last);
+        std::stable_sort(added.begin(), added.end(), std::cref(comp_));
+
+        // Слияние старых и новых ключей в новый буфер с отбрасыванием повторов. Если перемещение
+        // ключа может выбросить исключение, старые ключи копируются и при ошибке множество не меняется
+        Keys merged(keys_.GetAllocator());
+        merged.Reserve(keys_.GetSize() + added.GetSize());
+        Key* old_it = keys_.begin();
+        Key* const old_end = keys_.end();
+        Key* new_it = added.begin();
+        Key* const new_end = added.end();
+        while (old_it != old_end || new_it != new_end)
+        {
+            const bool take_old = new_it == new_end || (old_it != old_end && !comp_(*new_it, *old_it));
+            Key*& source = take_old ? old_it : new_it;
+            if (merged.IsEmpty() || comp_(merged[merged.GetSize() - 1], *source))
+            {
+                merged.PushBack(std::move_if_noexcept(*source));
+            }
+            ++source;
+        }
+        keys_.swap(merged);
+        RebuildIndex();
+    }
+
+    template <typename Range>
+    void InsertRange(const Range& range)
+    {
+        InsertRange(std::begin(range), std::end(range));
+    }
+
+    // Удаляет key. Возвращает количество удаленных ключей (0 или 1)
+    size_t Erase(const Key& key)
+    {
+        ConstIterator it = Find(key);
+        if (it == cend())
+        {
+            return 0;
+        }
+        Erase(it);
+        return 1;
+    }
+
+    // Удаляет ключ в позиции pos и возвращает итератор на следующий
+    ConstIterator Erase(ConstIterator pos)
+    {
+        ConstIterator next = keys_.Erase(pos);
+        RebuildIndex();
+        return next;
+    }
+
+    void swap(FlatSet& other) noexcept
+    {
+        keys_.swap(other.keys_);
+        std::swap(comp_, other.comp_);
+        std::swap(index_, other.index_);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return keys_.cbegin();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return keys_.cend();
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return keys_.cbegin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return keys_.cend();
+    }
+
+private:
+    Keys keys_;
+    Compare comp_;
+    Index index_;
+
+    template <typename Value>
+    std::pair<ConstIterator, bool> EmplaceAt(ConstIterator pos, Value&& key)
+    {
+        if (pos != cend() && !comp_(key, *pos))
+        {
+            return { pos, false };
+        }
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+        keys_.Insert(pos, std::forward<Value>(key));
+        RebuildIndex();
+        return { cbegin() + offset, true };
+    }
+
+    flat_search::Bound<Key> Search(const Key& key) const
+    {
+        return index_.LowerBound(keys_.cbegin(), keys_.GetSize(), key, comp_);
+    }
+
+    // Вызывается после того, как изменение уже применено, поэтому не выбрасывает исключений:
+    // если индекс перестроить не удалось, он помечен недействительным, и поиск идет по keys_
+    void RebuildIndex() noexcept
+    {
+        try
+        {
+            index_.Build(keys_.cbegin(), keys_.GetSize());
+        }
+        catch (...)
+        {
+        }
+    }
+};
+
+template <typename Key, typename Compare, typename Layout, typename Allocator>
+inline bool operator==(const FlatSet<Key, Compare, Layout, Allocator>& lhs, const FlatSet<Key, Compare, Layout, Allocator>& rhs)
+{
+    return lhs.GetKeys() == rhs.GetKeys();
+}
+
+template <typename Key, typename Compare, typename Layout, typename Allocator>
+inline bool operator!=(const FlatSet<Key, Compare, Layout, Allocator>& lhs, const FlatSet<Key, Compare, Layout, Allocator>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename Layout, typename Allocator>
+inline bool operator<(const FlatSet<Key, Compare, Layout, Allocator>& lhs, const FlatSet<Key, Compare, Layout, Allocator>& rhs)
+{
+    return lhs.GetKeys() < rhs.GetKeys();
+}
+
+template <typename Key, typename Compare, typename Layout, typename Allocator>
+inline bool operator<=(const FlatSet<Key, Compare, Layout, Allocator>& lhs, const FlatSet<Key, Compare, Layout, Allocator>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename Key, typename Compare, typename Layout, typename Allocator>
+inline bool operator>(const FlatSet<Key, Compare, Layout, Allocator>& lhs, const FlatSet<Key, Compare, Layout, Allocator>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename Key, typename Compare, typename Layout, typename Allocator>
+inline bool operator>=(const FlatSet<Key, Compare, Layout, Allocator>& lhs, const FlatSet<Key, Compare, Layout, Allocator>& rhs)
+{
+    return !(lhs < rhs);
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+// Политики роста емкости SimpleVector.
+// Политика - класс со статическим методом
+//     static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept
+// возвращающим новую емкость (в элементах) не меньше required при текущей емкости capacity,
+// и строкой name для вывода в замерах.
+// Политика может также уменьшать емкость после удаления элементов, предоставив метод
+//     static size_t ShrinkCapacity(size_t capacity, size_t size, size_t element_size) noexcept
+// возвращающий новую емкость не меньше size (capacity - не уменьшать)
+
+// Удвоение емкости (поведение SimpleVector по умолчанию)
+struct DoublingGrowth
+{
+    static constexpr std::string_view name = "2x";
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept
+    {
+        return std::max(required, capacity > 0 ? 2 * capacity : size_t{ 1 });
+    }
+};
+
+// Рост в 1.5 раза: меньший перерасход памяти, и сумма ранее освобожденных блоков со временем
+// превышает размер очередного запроса, так что распределитель может переиспользовать их
+struct OneAndHalfGrowth
+{
+    static constexpr std::string_view name = "1.5x";
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept
+    {
+        return std::max(required, capacity + std::max(capacity / 2, size_t{ 1 }));
+    }
+};
+
+// Округляет емкость базовой политики вверх до размерного класса распределителя памяти, чтобы
+// "хвост" блока, который malloc все равно выделит, был доступен вектору (та же емкость по памяти,
+// меньше переездов). Классы как у jemalloc/tcmalloc: шаг 16 байт до 128 байт,
+// далее по 4 класса на каждую степень двойки
+template <typename Base = DoublingGrowth>
+struct SizeClassGrowth
+{
+    static constexpr std::string_view name = "size-class";
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept
+    {
+        const size_t base_capacity = Base::NextCapacity(capacity, required, element_size);
+        const size_t bytes = RoundToSizeClass(base_capacity * element_size);
+        return std::max(base_capacity, bytes / element_size);
+    }
+
+    static size_t RoundToSizeClass(size_t bytes) noexcept
+    {
+        if (bytes <= 128)
+        {
+            return (bytes + 15) & ~size_t{ 15 };
+        }
+        // Шаг класса - четверть старшей степени двойки, не превосходящей bytes - 1
+        size_t power = 128;
+        while (power * 2 < bytes)
+        {
+            power *= 2;
+        }
+        const size_t step = power / 4;
+        return (bytes + step - 1) / step * step;
+    }
+};
+
+// Для больших буферов (от Threshold байт) округляет емкость базовой политики вверх до целого числа
+// страниц PageSize: такие блоки распределитель берет у системы страницами (mmap), и неполная
+// последняя страница иначе пропадает. Малые буферы растут по базовой политике
+template <typename Base = DoublingGrowth, size_t PageSize = 4096, size_t Threshold = 128 * 1024>
+struct PageGrowth
+{
+    static constexpr std::string_view name = "page";
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept
+    {
+        const size_t base_capacity = Base::NextCapacity(capacity, required, element_size);
+        const size_t bytes = base_capacity * element_size;
+        if (bytes < Threshold)
+        {
+            return base_capacity;
+        }
+        const size_t rounded = (bytes + PageSize - 1) / PageSize * PageSize;
+        return std::max(base_capacity, rounded / element_size);
+    }
+};
+
+// Уменьшает емкость, когда размер падает ниже 1/Fraction емкости: буфер переезжает в блок
+// удвоенного размера. После уменьшения до следующего переезда размер должен либо вырасти вдвое,
+// либо снова упасть в Fraction / 2 раз, поэтому чередование вставок и удалений на границе не вызывает
+// переездов, а их стоимость остается амортизированно постоянной. Буферы до MinBytes байт не уменьшаются,
+// так что Clear() оставляет небольшой буфер для повторного заполнения. Рост - по базовой политике
+template <typename Base = DoublingGrowth, size_t Fraction = 4, size_t MinBytes = 4096>
+struct ShrinkingGrowth
+{
+    static_assert(Fraction > 2, "Shrinking to twice the size requires Fraction > 2");
+
+    static constexpr std::string_view name = "shrinking";
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept
+    {
+        return Base::NextCapacity(capacity, required, element_size);
+    }
+
+    static size_t ShrinkCapacity(size_t capacity, size_t size, size_t element_size) noexcept
+    {
+        const size_t min_capacity = MinBytes / element_size;
+        if (capacity <= min_capacity || size >= capacity / Fraction)
+        {
+            return capacity;
+        }
+        return std::max(2 * size, min_capacity);
+    }
+};
+
+template <typename Policy, typename = void>
+struct has_shrink_capacity : std::false_type
+{
+};
+
+template <typename Policy>
+struct has_shrink_capacity<Policy, std::void_t<decltype(Policy::ShrinkCapacity(size_t{}, size_t{}, size_t{}))>>
+    : std::true_type
+{
+};
+
+template <typename Policy>
+inline constexpr bool has_shrink_capacity_v = has_shrink_capacity<Policy>::value;
@@ -0,0 +1,510 @@
+#pragma once
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "simple_vector.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Вектор с интерфейсом SimpleVector и постепенным переездом при росте.
+// Когда емкость исчерпана, PushBack/EmplaceBack выделяют новый буфер, но переносят в него не все
+// элементы сразу, а не более MigrationStep старых элементов за каждое последующее добавление.
+// Пока переезд не закончен, operator[] и At находят элемент в старом или новом буфере, поэтому
+// худшее время одного PushBack - O(MigrationStep), а не O(size).
+// При удвоении емкости переезд гарантированно завершается до следующего роста; иначе (или при
+// вызове операций, которым нужен непрерывный массив: итераторы, Insert, Erase, Reserve, Resize)
+// оставшиеся элементы переносятся сразу. Вне переезда хранилище - один непрерывный массив.
+// begin()/end() константного вектора тоже завершают переезд (состояние переезда mutable),
+// поэтому перед чтением из нескольких потоков вызовите FinishMigration()
+template <typename Type, typename Allocator = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth,
+          size_t MigrationStep = 4>
+class IncrementalSimpleVector
+{
+    static_assert(MigrationStep > 0, "MigrationStep must be positive");
+    static_assert(std::is_nothrow_move_constructible_v<Type> || is_trivially_relocatable_v<Type>,
+                  "Incremental migration requires nothrow relocation");
+
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+
+    IncrementalSimpleVector() noexcept(noexcept(Allocator()))
+    {
+    }
+
+    explicit IncrementalSimpleVector(const Allocator& alloc) noexcept : buffer_(alloc), old_buffer_(alloc)
+    {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit IncrementalSimpleVector(size_t size, const Allocator& alloc = Allocator())
+        : buffer_(size, alloc), old_buffer_(alloc), capacity_(size)
+    {
+        buffer_.UninitializedValueConstruct(buffer_.Get(), buffer_.Get() + size);
+        size_ = size;
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    IncrementalSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : buffer_(size, alloc), old_buffer_(alloc), capacity_(size)
+    {
+        buffer_.UninitializedFill(buffer_.Get(), buffer_.Get() + size, value);
+        size_ = size;
+    }
+
+    // Создаёт вектор из std::initializer_list
+    IncrementalSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : buffer_(init.size(), alloc), old_buffer_(alloc), capacity_(init.size())
+    {
+        buffer_.UninitializedCopy(init.begin(), init.end(), buffer_.Get());
+        size_ = init.size();
+    }
+
+    IncrementalSimpleVector(ReserveProxyObj obj, const Allocator& alloc = Allocator())
+        : buffer_(obj.reserve_value, alloc), old_buffer_(alloc), capacity_(obj.reserve_value)
+    {
+    }
+
+    IncrementalSimpleVector(const IncrementalSimpleVector& other)
+        : IncrementalSimpleVector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {
+    }
+
+    // Копирует элементы other в буфер, выделенный распределителем alloc
+    IncrementalSimpleVector(const IncrementalSimpleVector& other, const Allocator& alloc)
+        : IncrementalSimpleVector(alloc)
+    {
+        other.FinishMigration();
+        ArrayPtr<Type, Allocator> buffer(other.size_, buffer_.GetAllocator());
+        buffer.UninitializedCopy(other.begin(), other.end(), buffer.Get());
+        buffer_.swap(buffer);
+        size_ = capacity_ = other.size_;
+    }
+
+    // Распределитель rhs передается, только если propagate_on_container_copy_assignment,
+    // иначе копия строится в памяти распределителя *this
+    IncrementalSimpleVector& operator=(const IncrementalSimpleVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+            {
+                if (GetAllocator() != rhs.GetAllocator())
+                {
+                    // Память нужно вернуть прежнему распределителю до его замены
+                    Clear();
+                    buffer_.ResetAllocator(rhs.GetAllocator());
+                    old_buffer_.ResetAllocator(rhs.GetAllocator());
+                    capacity_ = 0;
+                }
+            }
+            IncrementalSimpleVector tmp(rhs, GetAllocator());
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    IncrementalSimpleVector(IncrementalSimpleVector&& other) noexcept
+        : buffer_(std::move(other.buffer_))
+        , old_buffer_(std::move(other.old_buffer_))
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , migrated_(std::exchange(other.migrated_, 0))
+        , old_size_(std::exchange(other.old_size_, 0))
+    {
+    }
+
+    // Буферы передаются, если передается распределитель (propagate_on_container_move_assignment)
+    // или распределители равны; иначе элементы перемещаются по одному в память *this
+    IncrementalSimpleVector& operator=(IncrementalSimpleVector&& rhs) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+    {
+        if (this != &rhs)
+        {
+            Clear();
+            if constexpr (!AllocTraits::propagate_on_container_move_assignment::value
+                          && !AllocTraits::is_always_equal::value)
+            {
+                if (GetAllocator() != rhs.GetAllocator())
+                {
+                    rhs.FinishMigration();
+                    Reserve(rhs.size_);
+                    buffer_.UninitializedMove(rhs.buffer_.Get(), rhs.buffer_.Get() + rhs.size_, buffer_.Get());
+                    size_ = rhs.size_;
+                    rhs.Clear();
+                    return *this;
+                }
+            }
+
+            buffer_ = std::move(rhs.buffer_);
+            old_buffer_ = std::move(rhs.old_buffer_);
+            size_ = std::exchange(rhs.size_, 0);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+            migrated_ = std::exchange(rhs.migrated_, 0);
+            old_size_ = std::exchange(rhs.old_size_, 0);
+        }
+        return *this;
+    }
+
+    ~IncrementalSimpleVector()
+    {
+        Clear();
+    }
+
+    Allocator GetAllocator() const noexcept
+    {
+        return buffer_.GetAllocator();
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept
+    {
+        return size_;
+    }
+
+    // Возвращает вместимость массива (нового буфера, если идет переезд)
+    size_t GetCapacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // Сообщает, остались ли элементы в старом буфере
+    bool IsMigrating() const noexcept
+    {
+        return migrated_ < old_size_;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        return *Locate(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept
+    {
+        assert(index < size_);
+        return *Locate(index);
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index)
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator At())");
+        }
+        return *Locate(index);
+    }
+
+    const Type& At(size_t index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator const At())");
+        }
+        return *Locate(index);
+    }
+
+    // Разрушает все элементы и обнуляет размер массива, не изменяя его вместимость
+    void Clear() noexcept
+    {
+        buffer_.Destroy(buffer_.Get(), buffer_.Get() + migrated_);
+        old_buffer_.Destroy(old_buffer_.Get() + migrated_, old_buffer_.Get() + old_size_);
+        buffer_.Destroy(buffer_.Get() + old_size_, buffer_.Get() + size_);
+        ReleaseOldBuffer();
+        size_ = 0;
+    }
+
+    // Изменяет размер массива. Новые элементы получают значение по умолчанию,
+    // лишние элементы разрушаются
+    void Resize(size_t new_size)
+    {
+        FinishMigration();
+        if (new_size <= size_)
+        {
+            buffer_.Destroy(buffer_.Get() + new_size, buffer_.Get() + size_);
+            size_ = new_size;
+            return;
+        }
+        if (new_size > capacity_)
+        {
+            Reserve(GrowthPolicy::NextCapacity(capacity_, new_size, sizeof(Type)));
+        }
+        buffer_.UninitializedValueConstruct(buffer_.Get() + size_, buffer_.Get() + new_size);
+        size_ = new_size;
+    }
+
+    // Конструирует элемент из args в конце вектора и переносит очередную порцию старых элементов
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args)
+    {
+        if (size_ == capacity_)
+        {
+            if (IsMigrating())
+            {
+                // Рост до конца переезда: args могут ссылаться на элемент, который сейчас переедет
+                Type item(std::forward<Args>(args)...);
+                FinishMigration();
+                StartMigration();
+                return ConstructBack(std::move(item));
+            }
+            // Старые элементы остаются на месте, так что ссылки в args действительны
+            StartMigration();
+        }
+        return ConstructBack(std::forward<Args>(args)...);
+    }
+
+    void PushBack(const Type& item)
+    {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item)
+    {
+        EmplaceBack(std::move(item));
+    }
+
+    // Вставляет значение в позицию pos, сдвигая последующие элементы. Завершает переезд.
+    // Возвращает итератор на вставленное значение
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args)
+    {
+        assert(pos >= cbegin() && pos <= cend());
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+        EmplaceBack(std::forward<Args>(args)...);
+        std::rotate(begin() + offset, end() - 1, end());
+        return begin() + offset;
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value)
+    {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value)
+    {
+        return Emplace(pos, std::move(value));
+    }
+
+    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept
+    {
+        assert(size_ > 0);
+        const size_t index = --size_;
+        if (index < old_size_)
+        {
+            // Все добавленные после роста элементы уже удалены, последний еще в старом буфере
+            assert(index >= migrated_);
+            old_buffer_.Destroy(old_buffer_.Get() + index, old_buffer_.Get() + index + 1);
+            old_size_ = index;
+            if (!IsMigrating())
+            {
+                ReleaseOldBuffer();
+            }
+            return;
+        }
+        buffer_.Destroy(buffer_.Get() + index, buffer_.Get() + index + 1);
+    }
+
+    // Удаляет элемент вектора в указанной позиции. Завершает переезд
+    Iterator Erase(ConstIterator pos)
+    {
+        assert(pos >= cbegin() && pos < cend());
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+        std::move(begin() + offset + 1, end(), begin() + offset);
+        PopBack();
+        return begin() + offset;
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(IncrementalSimpleVector& other) noexcept
+    {
+        buffer_.swap(other.buffer_);
+        old_buffer_.swap(other.old_buffer_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(migrated_, other.migrated_);
+        std::swap(old_size_, other.old_size_);
+    }
+
+    // Увеличивает емкость до new_capacity сразу, с переносом всех элементов
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity <= capacity_)
+        {
+            return;
+        }
+        FinishMigration();
+        ArrayPtr<Type, Allocator> buffer(new_capacity, buffer_.GetAllocator());
+        buffer.Relocate(buffer_.Get(), buffer_.Get() + size_, buffer.Get());
+        buffer_.swap(buffer);
+        capacity_ = new_capacity;
+    }
+
+    // Переносит все оставшиеся элементы из старого буфера. Логически константна: значения
+    // элементов не меняются, но ссылки на элементы старого буфера становятся недействительными
+    void FinishMigration() const noexcept
+    {
+        if (IsMigrating())
+        {
+            MigrateElements(old_size_ - migrated_);
+        }
+    }
+
+    Iterator begin() noexcept
+    {
+        FinishMigration();
+        return buffer_.Get();
+    }
+
+    Iterator end() noexcept
+    {
+        FinishMigration();
+        return buffer_.Get() + size_;
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return cbegin();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return cend();
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        FinishMigration();
+        return buffer_.Get();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        FinishMigration();
+        return buffer_.Get() + size_;
+    }
+
+private:
+    // Элементы [0, migrated_) и [old_size_, size_) лежат в buffer_, [migrated_, old_size_) - в old_buffer_
+    mutable ArrayPtr<Type, Allocator> buffer_;
+    mutable ArrayPtr<Type, Allocator> old_buffer_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    mutable size_t migrated_ = 0;
+    mutable size_t old_size_ = 0;
+
+    Type* Locate(size_t index) const noexcept
+    {
+        if (index >= migrated_ && index < old_size_)
+        {
+            return old_buffer_.Get() + index;
+        }
+        return buffer_.Get() + index;
+    }
+
+    // Выделяет новый буфер; все элементы пока остаются в текущем, который становится старым
+    void StartMigration()
+    {
+        assert(!IsMigrating());
+        ArrayPtr<Type, Allocator> buffer(GrowthPolicy::NextCapacity(capacity_, size_ + 1, sizeof(Type)),
+                                         buffer_.GetAllocator());
+        capacity_ = buffer.GetSize();
+        old_buffer_ = std::move(buffer_);
+        buffer_ = std::move(buffer);
+        migrated_ = 0;
+        old_size_ = size_;
+        if (old_size_ == 0)
+        {
+            ReleaseOldBuffer();
+        }
+    }
+
+    template <typename... Args>
+    Type& ConstructBack(Args&&... args)
+    {
+        Type* item = buffer_.Get() + size_;
+        buffer_.Construct(item, std::forward<Args>(args)...);
+        ++size_;
+        if (IsMigrating())
+        {
+            MigrateElements(std::min(MigrationStep, old_size_ - migrated_));
+        }
+        return *item;
+    }
+
+    // Переносит count следующих элементов из старого буфера в новый
+    void MigrateElements(size_t count) const noexcept
+    {
+        buffer_.Relocate(old_buffer_.Get() + migrated_, old_buffer_.Get() + migrated_ + count, buffer_.Get() + migrated_);
+        migrated_ += count;
+        if (!IsMigrating())
+        {
+            ReleaseOldBuffer();
+        }
+    }
+
+    void ReleaseOldBuffer() const noexcept
+    {
+        old_buffer_ = ArrayPtr<Type, Allocator>(old_buffer_.GetAllocator());
+        migrated_ = 0;
+        old_size_ = 0;
+    }
+};
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline bool operator==(const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& lhs,
+                       const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& rhs)
+{
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline bool operator!=(const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& lhs,
+                       const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline bool operator<(const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& lhs,
+                      const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& rhs)
+{
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline bool operator<=(const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& lhs,
+                       const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline bool operator>(const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& lhs,
+                      const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline bool operator>=(const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& lhs,
+                       const IncrementalSimpleVector<Type, Allocator, GrowthPolicy, MigrationStep>& rhs)
+{
+    return !(lhs < rhs);
+}
@@ -1,9 +1,40 @@
+#include "bit_vector.h"
+#include "concurrent_simple_vector.h"
+#include "flat_map.h"
+#include "flat_set.h"
+#include "incremental_simple_vector.h"
+#include "malloc_allocator.h"
+#include "mmap_allocator.h"
+#include "parallel_for.h"
+#include "pool_allocator.h"
+#include "segmented_simple_vector.h"
+#include "shared_simple_vector.h"
 #include "simple_vector.h"
+#include "simple_vector_file.h"
+#include "simple_vector_stream.h"
+#include "simple_vector_view.h"
+#include "small_simple_vector.h"
+#include "soa_vector.h"
+#include "static_vector.h"
 
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <set>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <thread>
 
 using namespace std;
 
@@ -150,6 +181,1369 @@ void TestNoncopiableErase() {
     cout << "Done!"s << endl << endl;
 }
 
+// Тип, считающий количество живых экземпляров
+struct Counted {
+    static inline int alive = 0;
+    Counted() {
+        ++alive;
+    }
+    Counted(const Counted&) {
+        ++alive;
+    }
+    Counted(Counted&&) noexcept {
+        ++alive;
+    }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() {
+        --alive;
+    }
+};
+
+void TestRawStorage() {
+    cout << "Test raw storage: reserve does not construct, pop/clear destroy"s << endl;
+    {
+        SimpleVector<Counted> v(Reserve(1000));
+        assert(Counted::alive == 0);
+        v.Reserve(100000);
+        assert(Counted::alive == 0);
+
+        v.Resize(10);
+        assert(Counted::alive == 10);
+        v.PushBack(Counted());
+        assert(Counted::alive == 11);
+        v.PopBack();
+        assert(Counted::alive == 10);
+        v.Erase(v.begin());
+        assert(Counted::alive == 9);
+        v.Insert(v.begin() + 3, Counted());
+        assert(Counted::alive == 10);
+        v.Resize(4);
+        assert(Counted::alive == 4);
+        v.Clear();
+        assert(Counted::alive == 0);
+        v.Resize(3);
+    }
+    assert(Counted::alive == 0);
+
+    SimpleVector<int> v(5, 7);
+    assert(v.GetSize() == 5 && v[0] == 7 && v[4] == 7);
+    v.PushBack(v[0]);
+    v.Insert(v.begin(), v[5]);
+    assert(v.GetSize() == 7 && v[0] == 7 && v[6] == 7);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestPmrAllocator() {
+    cout << "Test pmr allocator"s << endl;
+    std::byte buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    ::pmr::SimpleVector<std::pmr::string> v(&arena);
+    for (int i = 0; i < 10; ++i) {
+        v.PushBack(std::pmr::string(3, static_cast<char>('a' + i)));
+    }
+    v.Insert(v.begin(), std::pmr::string("front"));
+    assert(v.GetSize() == 11 && v[0] == "front" && v[10] == "jjj");
+    // Элементы конструируются через распределитель и получают ресурс вектора
+    assert(v[1].get_allocator().resource() == &arena);
+
+    // Перемещение между разными ресурсами выполняется поэлементно
+    std::pmr::unsynchronized_pool_resource pool;
+    ::pmr::SimpleVector<std::pmr::string> other(&pool);
+    other = std::move(v);
+    assert(other.GetAllocator().resource() == &pool);
+    assert(other.GetSize() == 11 && other[10] == "jjj" && v.IsEmpty());
+
+    ::pmr::SimpleVector<std::pmr::string> copy(other);
+    assert(copy == other);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSmallSimpleVector() {
+    cout << "Test small vector with inline storage"s << endl;
+    SmallSimpleVector<X, 4> v;
+    for (size_t i = 0; i < 4; ++i) {
+        v.PushBack(X(i));
+    }
+    assert(v.IsInline() && v.GetCapacity() == 4);
+    v.Insert(v.begin(), X(10));
+    assert(!v.IsInline() && v.GetSize() == 5 && v[0].GetX() == 10 && v[4].GetX() == 3);
+    v.Erase(v.begin());
+    assert(v[0].GetX() == 0);
+
+    SmallSimpleVector<X, 4> moved(std::move(v));
+    assert(moved.GetSize() == 4 && v.IsEmpty() && v.IsInline());
+
+    SmallSimpleVector<string, 2> a{ "a"s, "b"s };
+    SmallSimpleVector<string, 2> b(a);
+    assert(a == b && a.IsInline());
+    b.PushBack("c"s);
+    assert(a < b && b.GetSize() == 3);
+    a.swap(b);
+    assert(a.GetSize() == 3 && b.GetSize() == 2 && b.IsInline());
+    b = a;
+    assert(a == b);
+    b.Resize(1);
+    assert(b.GetSize() == 1 && b[0] == "a"s);
+
+    // Присваивание между векторами на разных ресурсах: распределитель не передается, и
+    // перемещение может выделять память, поэтому оно не noexcept
+    using PmrSmall = SmallSimpleVector<int, 4, std::pmr::polymorphic_allocator<int>>;
+    static_assert(!is_nothrow_move_assignable_v<PmrSmall> && is_nothrow_move_assignable_v<SmallSimpleVector<int, 4>>);
+    std::pmr::unsynchronized_pool_resource first_pool;
+    std::pmr::unsynchronized_pool_resource second_pool;
+    PmrSmall source(100, 7, &first_pool);
+    PmrSmall target(10, 1, &second_pool);
+    target = source;
+    assert(target == source && !target.IsInline() && target.GetAllocator().resource() == &second_pool);
+    PmrSmall moved_target(&second_pool);
+    moved_target = std::move(source);
+    assert(moved_target == target && source.IsEmpty() && moved_target.GetAllocator().resource() == &second_pool);
+    cout << "Done!"s << endl << endl;
+}
+
+// Тип с владеющим указателем: не тривиально копируемый, но перемещаемый побайтово
+struct Relocatable {
+    std::unique_ptr<int> value;
+};
+
+template <>
+struct is_trivially_relocatable<Relocatable> : std::true_type {};
+
+void TestTriviallyRelocatable() {
+    cout << "Test memcpy/realloc paths for trivially relocatable types"s << endl;
+    SimpleVector<int, MallocAllocator<int>> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.PushBack(i);
+    }
+    v.Insert(v.begin(), -1);
+    v.Insert(v.begin() + 500, v[0]);
+    v.Erase(v.begin() + 1);
+    assert(v.GetSize() == 1001 && v[0] == -1 && v[1] == 1 && v[499] == -1 && v[1000] == 999);
+    v.Resize(5000);
+    assert(v[4999] == 0 && v[999] == 998);
+    v.Reserve(100000);
+    assert(v[999] == 998);
+
+    SimpleVector<Relocatable> r;
+    for (int i = 0; i < 100; ++i) {
+        r.PushBack(Relocatable{ std::make_unique<int>(i) });
+    }
+    r.Insert(r.begin(), Relocatable{ std::make_unique<int>(-1) });
+    r.Erase(r.begin() + 50);
+    assert(r.GetSize() == 100 && *r[0].value == -1 && *r[49].value == 48 && *r[50].value == 50);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestEmplaceAndRangeInsert() {
+    cout << "Test emplace and range insert"s << endl;
+    SimpleVector<pair<string, int>> v;
+    v.EmplaceBack("b"s, 2);
+    v.Emplace(v.begin(), "a"s, 1);
+    assert(v.GetSize() == 2 && v[0].first == "a"s && v[1].second == 2);
+
+    SimpleVector<string> s{ "a"s, "e"s };
+    const string middle[] = { "b"s, "c"s, "d"s };
+    s.Insert(s.begin() + 1, begin(middle), end(middle));
+    assert((s == SimpleVector<string>{ "a"s, "b"s, "c"s, "d"s, "e"s }));
+    // Вставка в пределах емкости: хвост длиннее и короче вставляемого диапазона
+    s.Reserve(100);
+    s.Insert(s.begin() + 1, 2, "x"s);
+    assert((s == SimpleVector<string>{ "a"s, "x"s, "x"s, "b"s, "c"s, "d"s, "e"s }));
+    s.Insert(s.end() - 1, begin(middle), end(middle));
+    assert((s == SimpleVector<string>{ "a"s, "x"s, "x"s, "b"s, "c"s, "d"s, "b"s, "c"s, "d"s, "e"s }));
+    s.Insert(s.begin(), 1, s[9]);
+    assert(s[0] == "e"s && s.GetSize() == 11);
+
+    SimpleVector<int> ints(Reserve(4));
+    const int values[] = { 1, 2, 3, 4, 5, 6 };
+    ints.Append(begin(values), end(values));
+    assert(ints.GetSize() == 6 && ints.GetCapacity() == 8);
+    ints.Insert(ints.begin() + 2, 2, 0);
+    assert((ints == SimpleVector<int>{ 1, 2, 0, 0, 3, 4, 5, 6 }));
+
+    istringstream input("7 8 9"s);
+    ints.Insert(ints.begin(), istream_iterator<int>(input), istream_iterator<int>());
+    assert(ints.GetSize() == 11 && ints[0] == 7 && ints[3] == 1);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestVectorStats() {
+    cout << "Test vector statistics policy"s << endl;
+    static_assert(sizeof(SimpleVector<int, std::allocator<int>, DoublingGrowth, NoVectorStats>) == 2 * sizeof(size_t) + sizeof(ArrayPtr<int>));
+
+    using CountedVector = SimpleVector<string, std::allocator<string>, DoublingGrowth, CountingVectorStats<string>>;
+    {
+        CountedVector v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(to_string(i));
+        }
+        // Емкость 1 -> 2 -> 4 -> 8
+        VectorStatsCounters stats = v.GetStats();
+        assert(stats.allocations == 4 && stats.deallocations == 3 && stats.growths == 4);
+        assert(stats.peak_capacity == 8 && stats.wasted_capacity == 3);
+        assert(stats.elements_moved == 5 + 0 + 1 + 2 + 4);
+
+        const string value = "x"s;
+        v.Insert(v.begin(), value);
+        v.Erase(v.begin());
+        stats = v.GetStats();
+        assert(stats.elements_copied == 1 && stats.elements_moved == 12 + 6 + 5);
+
+        CountedVector copy(v);
+        assert(copy.GetStats().elements_copied == 5 && copy.GetStats().allocations == 1);
+    }
+    const VectorStatsCounters total = CountingVectorStats<string>::Aggregate().GetCounters();
+    assert(total.allocations == 5 && total.deallocations == 5 && total.destroyed_vectors == 2);
+    assert(total.wasted_capacity == 3);
+
+    ostringstream dump;
+    VectorStatsRegistry::Instance().Dump(dump);
+    assert(dump.str().find("std::__cxx11::basic_string"s) != string::npos || dump.str().find("string"s) != string::npos);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestGrowthPolicy() {
+    cout << "Test growth policies"s << endl;
+    SimpleVector<int, std::allocator<int>, OneAndHalfGrowth> v;
+    size_t last_capacity = 0;
+    SimpleVector<size_t> capacities;
+    for (int i = 0; i < 20; ++i) {
+        v.PushBack(i);
+        if (v.GetCapacity() != last_capacity) {
+            last_capacity = v.GetCapacity();
+            capacities.PushBack(last_capacity);
+        }
+    }
+    assert((capacities == SimpleVector<size_t>{ 1, 2, 3, 4, 6, 9, 13, 19, 28 }));
+    v.Resize(100);
+    assert(v.GetCapacity() == 100);
+
+    // 3 * 4 байта округляются до класса 16 байт
+    assert((SizeClassGrowth<>::NextCapacity(2, 3, sizeof(int)) == 4));
+    assert((SizeClassGrowth<>::NextCapacity(0, 1, 24) == 1));
+    assert((SizeClassGrowth<>::RoundToSizeClass(129) == 160));
+    assert((SizeClassGrowth<>::RoundToSizeClass(1000) == 1024));
+    assert((PageGrowth<>::NextCapacity(10, 11, 1) == 20));
+    assert((PageGrowth<>::NextCapacity(100000, 100001, 1) == 200704));
+    cout << "Done!"s << endl << endl;
+}
+
+void TestMmapAllocator() {
+    cout << "Test mmap/mremap storage"s << endl;
+    // Порог 16 КБ: вектор начинает в malloc, затем переезжает в mmap и растет через mremap
+    SimpleVector<int, MmapAllocator<int, 16 * 1024, true>> v;
+    for (int i = 0; i < 1000000; ++i) {
+        v.PushBack(i);
+    }
+    v.Insert(v.begin(), -1);
+    assert(v.GetSize() == 1000001 && v[0] == -1 && v[1] == 0 && v[1000000] == 999999);
+    v.Resize(10);
+    SimpleVector<int, MmapAllocator<int, 16 * 1024, true>> copy(v);
+    assert(copy == v);
+
+    // Нетривиально перемещаемые элементы переезжают поэлементно, но память тоже берется из mmap
+    SimpleVector<string, MmapAllocator<string, 4096>> strings;
+    for (int i = 0; i < 1000; ++i) {
+        strings.PushBack(to_string(i));
+    }
+    assert(strings[999] == "999"s);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSimdKernels() {
+    cout << "Test SIMD kernels"s << endl;
+    AlignedSimpleVector<int32_t, 64> aligned(37, 5);
+    assert(reinterpret_cast<uintptr_t>(aligned.begin()) % 64 == 0);
+    assert(Count(aligned, 5) == 37);
+
+    // Размеры с "хвостом", не кратным ширине регистра
+    for (size_t size : {0, 1, 7, 8, 9, 33}) {
+        SimpleVector<int32_t> ints(size);
+        iota(ints.begin(), ints.end(), -3);
+        SimpleVector<int32_t> same(ints);
+        assert(ints == same && !(ints < same));
+        if (size > 0) {
+            same[size - 1] += 1;
+            assert(ints != same && ints < same && same > ints);
+            const int32_t last = ints[size - 1];
+            assert(Find(ints, last) == ints.end() - 1);
+            assert(Sum(ints) == accumulate(ints.begin(), ints.end(), 0));
+            assert(MinMax(ints) == make_pair(int32_t{ -3 }, last));
+        }
+        assert(Find(ints, 1000) == ints.end());
+    }
+    assert((SimpleVector<int32_t>{ 1, 2 } < SimpleVector<int32_t>{ 1, 2, 0 }));
+
+    SimpleVector<float> floats(20, 0.5f);
+    floats[13] = -2.0f;
+    floats[17] = 8.0f;
+    assert(Sum(floats) == 15.0f);
+    assert(MinMax(floats) == make_pair(-2.0f, 8.0f));
+    assert(Count(floats, 0.5f) == 18 && Find(floats, 8.0f) == floats.begin() + 17);
+
+    // NaN не равен сам себе, но не решает исход лексикографического сравнения
+    SimpleVector<float> with_nan(floats);
+    with_nan[3] = NAN;
+    assert(with_nan != with_nan);
+    SimpleVector<float> bigger(with_nan);
+    bigger[18] = 1.0f;
+    assert(with_nan < bigger && !(bigger < with_nan));
+    cout << "Done!"s << endl << endl;
+}
+
+// Тип с потокобезопасным счетчиком живых экземпляров, копирование которого
+// начинает бросать исключения после copies_left копий
+struct ThrowingCopy {
+    static inline atomic<int> alive = 0;
+    static inline atomic<int> copies_left = 0;
+    ThrowingCopy() {
+        ++alive;
+    }
+    ThrowingCopy(const ThrowingCopy&) {
+        if (--copies_left < 0) {
+            throw runtime_error("copy failed"s);
+        }
+        ++alive;
+    }
+    ~ThrowingCopy() {
+        --alive;
+    }
+};
+
+void TestParallelOperations() {
+    cout << "Test parallel construction, fill, copy and comparison"s << endl;
+    // Маленькие куски, чтобы работа делилась между потоками и на малых размерах
+    const parallel::ParallelPolicy policy{ 4, 1024 };
+    const size_t size = 1000003;
+
+    SimpleVector<int> filled(policy, size, 7);
+    assert(filled.GetSize() == size && Count(filled, 7) == size);
+    SimpleVector<int> zeros(policy, size);
+    assert(Count(zeros, 0) == size);
+
+    SimpleVector<int> source = GenerateVector(size);
+    SimpleVector<int> copy(policy, source);
+    assert(copy == source && Equal(policy, copy, source));
+    copy[size - 1] = 0;
+    assert(!Equal(policy, copy, source));
+    copy.Fill(policy, 3);
+    assert(Count(copy, 3) == size && !Equal(policy, copy, filled));
+    filled.Fill(3);
+    assert(Equal(parallel::par, copy, filled));
+
+    SimpleVector<string> strings(policy, 10000, "text"s);
+    SimpleVector<string> strings_copy(policy, strings);
+    assert(Equal(policy, strings, strings_copy) && strings_copy[9999] == "text"s);
+
+    // Исключение в одном из потоков: созданные куски разрушаются, исключение пробрасывается
+    {
+        SimpleVector<ThrowingCopy> items(policy, 100000);
+        assert(ThrowingCopy::alive == 100000);
+        ThrowingCopy::copies_left = 70000;
+        bool thrown = false;
+        try {
+            SimpleVector<ThrowingCopy> items_copy(policy, items);
+        } catch (const runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && ThrowingCopy::alive == 100000);
+    }
+    assert(ThrowingCopy::alive == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestConcurrentSimpleVector() {
+    cout << "Test ConcurrentSimpleVector with concurrent writers and readers"s << endl;
+    const size_t writers = 4;
+    const size_t per_writer = 50000;
+    ConcurrentSimpleVector<size_t> v;
+    v.PushBack(size_t{ 0 });
+    const size_t* first = &v[0];
+
+    atomic<bool> done = false;
+    atomic<size_t> seen = 0;
+    // Читатель проверяет опубликованные элементы, пока писатели добавляют новые
+    thread reader([&] {
+        while (!done) {
+            const size_t size = v.GetSize();
+            for (size_t i = 0; i < size; ++i) {
+                if (const size_t* item = v.TryGet(i)) {
+                    assert(*item <= writers * per_writer);
+                    ++seen;
+                }
+            }
+        }
+    });
+    vector<thread> threads;
+    for (size_t w = 0; w < writers; ++w) {
+        threads.emplace_back([&v, w, per_writer] {
+            for (size_t i = 0; i < per_writer; ++i) {
+                const size_t index = v.PushBack(w * per_writer + i + 1);
+                assert(v.IsPublished(index));
+            }
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    done = true;
+    reader.join();
+
+    // Каждое значение добавлено ровно один раз, элементы не перемещались
+    assert(v.GetSize() == writers * per_writer + 1);
+    assert(&v[0] == first && *first == 0);
+    vector<bool> present(writers * per_writer + 1, false);
+    v.ForEachPublished([&present](size_t, size_t value) {
+        assert(!present[value]);
+        present[value] = true;
+    });
+    assert(count(present.begin(), present.end(), true) == static_cast<ptrdiff_t>(present.size()));
+
+    ConcurrentSimpleVector<string> strings;
+    strings.Reserve(100);
+    assert(strings.IsEmpty() && !strings.IsPublished(0) && strings.TryGet(0) == nullptr);
+    assert(strings.EmplaceBack(3, 'a') == 0 && strings[0] == "aaa"s);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSegmentedSimpleVector() {
+    cout << "Test SegmentedSimpleVector: growth does not move elements"s << endl;
+    SegmentedSimpleVector<int, 16> v;
+    v.PushBack(0);
+    const int* first = &v[0];
+    for (int i = 1; i < 1000; ++i) {
+        v.PushBack(i);
+    }
+    assert(&v[0] == first && v.GetSize() == 1000 && v.GetCapacity() == 1008);
+    assert(equal(v.begin(), v.end(), GenerateVector(1000).begin(), [](int lhs, int rhs) { return lhs + 1 == rhs; }));
+    assert(v.end() - v.begin() == 1000 && *(v.begin() + 517) == 517 && v.cend()[-1] == 999);
+
+    const int* middle = &v[500];
+    v.PopBack();
+    v.Reserve(5000);
+    v.Resize(2000);
+    assert(&v[500] == middle && v[998] == 998 && v[1999] == 0);
+
+    v.Insert(v.begin() + 20, -1);
+    assert(v[19] == 19 && v[20] == -1 && v[21] == 20);
+    v.Erase(v.begin() + 20);
+    assert(v[20] == 20 && v.GetSize() == 2000);
+    v.PushBack(v[3]);
+    assert(v[2000] == 3);
+
+    SegmentedSimpleVector<int, 16> copy(v);
+    assert(copy == v && !(copy < v));
+    copy[5] = 100;
+    assert(v < copy);
+    SegmentedSimpleVector<int, 16> moved(move(copy));
+    assert(copy.IsEmpty() && moved[5] == 100);
+
+    {
+        SegmentedSimpleVector<Counted> counted(100);
+        counted.Erase(counted.begin());
+        counted.Resize(10);
+        assert(Counted::alive == 10);
+    }
+    assert(Counted::alive == 0);
+
+    SegmentedSimpleVector<string> strings = { "a"s, "b"s };
+    strings.Insert(strings.begin(), "c"s);
+    assert(strings[0] == "c"s && strings[2] == "b"s);
+
+    // Присваивание между векторами на разных ресурсах: распределитель не передается,
+    // элементы копируются и перемещаются в блоки ресурса левого операнда
+    using PmrSegmented = SegmentedSimpleVector<int, 16, std::pmr::polymorphic_allocator<int>>;
+    std::pmr::unsynchronized_pool_resource first_pool;
+    std::pmr::unsynchronized_pool_resource second_pool;
+    PmrSegmented source(100, 7, &first_pool);
+    PmrSegmented target(10, 1, &second_pool);
+    target = source;
+    assert(target == source && target.GetAllocator().resource() == &second_pool);
+    PmrSegmented moved_target(&second_pool);
+    moved_target = move(source);
+    assert(moved_target == target && source.IsEmpty() && moved_target.GetAllocator().resource() == &second_pool);
+    source = move(target);
+    assert(source.GetSize() == 100 && source.GetAllocator().resource() == &first_pool);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestIncrementalSimpleVector() {
+    cout << "Test IncrementalSimpleVector: migration spread over PushBack calls"s << endl;
+    IncrementalSimpleVector<string, std::allocator<string>, DoublingGrowth, 2> v;
+    for (int i = 0; i < 64; ++i) {
+        v.PushBack(to_string(i));
+    }
+    assert(v.GetCapacity() == 64 && !v.IsMigrating());
+
+    // Рост: новый буфер выделен, старые элементы переезжают по 2 за добавление
+    v.PushBack(v[10]);
+    assert(v.GetCapacity() == 128 && v.IsMigrating());
+    for (int i = 0; i < 64; ++i) {
+        assert(v[i] == to_string(i));
+    }
+    assert(v[64] == "10"s);
+    for (int i = 0; i < 20; ++i) {
+        v.PushBack("x"s);
+    }
+    assert(v.IsMigrating() && v[63] == "63"s && v[0] == "0"s && v.At(84) == "x"s);
+    for (int i = 0; i < 20; ++i) {
+        v.PopBack();
+    }
+    v.PopBack();
+    v.PopBack();
+    assert(v.GetSize() == 63 && v.IsMigrating() && v[62] == "62"s);
+
+    IncrementalSimpleVector<string, std::allocator<string>, DoublingGrowth, 2> copy(v);
+    assert(copy == v && !v.IsMigrating() && copy.GetSize() == 63);
+    v.Insert(v.begin() + 1, "ins"s);
+    v.Erase(v.begin());
+    assert(v[0] == "ins"s && v[1] == "1"s && copy < v);
+
+    // Переезд заканчивается до следующего роста, Clear разрушает элементы обоих буферов
+    {
+        IncrementalSimpleVector<Counted> counted;
+        for (int i = 0; i < 1000; ++i) {
+            counted.PushBack(Counted());
+            assert(counted.GetSize() <= counted.GetCapacity());
+        }
+        assert(Counted::alive == 1000);
+        counted.Resize(10);
+        counted.Clear();
+        assert(Counted::alive == 0);
+        counted.Resize(3);
+    }
+    assert(Counted::alive == 0);
+
+    // Присваивание между векторами на разных ресурсах, в том числе во время переезда:
+    // распределитель не передается, элементы копируются и перемещаются в память левого операнда
+    using PmrIncremental = IncrementalSimpleVector<int, std::pmr::polymorphic_allocator<int>>;
+    std::pmr::unsynchronized_pool_resource first_pool;
+    std::pmr::unsynchronized_pool_resource second_pool;
+    PmrIncremental source(&first_pool);
+    for (int i = 0; i < 33; ++i) {
+        source.PushBack(i);
+    }
+    assert(source.IsMigrating());
+    PmrIncremental moved_target(&second_pool);
+    moved_target = move(source);
+    assert(moved_target.GetSize() == 33 && moved_target[32] == 32 && source.IsEmpty());
+    assert(moved_target.GetAllocator().resource() == &second_pool);
+    PmrIncremental target(10, 1, &first_pool);
+    target = moved_target;
+    assert(target == moved_target && target.GetAllocator().resource() == &first_pool);
+    source = move(target);
+    assert(source.GetSize() == 33 && source[32] == 32 && source.GetAllocator().resource() == &first_pool);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSharedSimpleVector() {
+    cout << "Test SharedSimpleVector: copies share the buffer until the first write"s << endl;
+    SharedSimpleVector<string> table = { "a"s, "b"s, "c"s };
+    const string* data = table.cbegin();
+    SharedSimpleVector<string> snapshot(table);
+    assert(table.GetUseCount() == 2 && snapshot.SharesBufferWith(table) && snapshot.cbegin() == data);
+
+    // Чтение через константный интерфейс не клонирует буфер
+    const SharedSimpleVector<string>& const_snapshot = snapshot;
+    assert(const_snapshot[1] == "b"s && const_snapshot.At(2) == "c"s && snapshot == table);
+    assert(table.GetUseCount() == 2);
+
+    // Первая запись клонирует, оригинал не меняется
+    snapshot.PushBack(snapshot[0]);
+    assert(!snapshot.SharesBufferWith(table) && table.GetUseCount() == 1 && snapshot.GetUseCount() == 1);
+    assert(table.GetSize() == 3 && snapshot.GetSize() == 4 && snapshot[3] == "a"s);
+    assert(table.cbegin() == data);
+    snapshot[0] = "z"s;
+    assert(table[0] == "a"s && table < snapshot);
+
+    SharedSimpleVector<string> other = table;
+    other.Insert(other.cbegin() + 1, "x"s);
+    other.Erase(other.cbegin());
+    assert(other[0] == "x"s && table[1] == "b"s && other.GetSize() == 3);
+    other = table;
+    other.Clear();
+    assert(other.IsEmpty() && table.GetSize() == 3 && table.GetUseCount() == 1);
+
+    // Снимки в потоках: каждый поток читает свою копию, пишущие потоки клонируют
+    SharedSimpleVector<int> numbers(1000, 1);
+    vector<thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([snapshot = numbers, t]() mutable {
+            assert(accumulate(snapshot.cbegin(), snapshot.cend(), 0) == 1000);
+            if (t % 2 == 0) {
+                snapshot[0] = t;
+                assert(snapshot.GetUseCount() == 1);
+            }
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    assert(numbers.GetUseCount() == 1 && numbers[0] == 1);
+
+    // Ссылка, выданная до копирования, не меняет снимок: буфер с выданными ссылками не разделяется
+    SharedSimpleVector<int> source = { 1, 2, 3 };
+    int& first = source[0];
+    SharedSimpleVector<int> frozen(source);
+    first = 42;
+    assert(frozen[0] == 1 && source[0] == 42 && !frozen.SharesBufferWith(source));
+    int* items = source.begin();
+    SharedSimpleVector<int> frozen_again = source;
+    items[1] = 7;
+    assert(frozen_again.cbegin()[1] == 2 && source.cbegin()[1] == 7);
+    // Clear делает выданные ссылки недействительными, и буфер снова разделяется
+    source.Clear();
+    source.PushBack(5);
+    SharedSimpleVector<int> shared_again(source);
+    assert(shared_again.SharesBufferWith(source) && source.GetUseCount() == 2);
+
+    SharedSimpleVector<int> adopted(SimpleVector<int>{ 1, 2, 3 });
+    assert(adopted.GetSize() == 3 && adopted[2] == 3);
+    cout << "Done!"s << endl << endl;
+}
+
+struct alignas(16) Point3 {
+    float x, y, z;
+};
+
+void TestMappedFile() {
+    cout << "Test Save and OpenMapped"s << endl;
+    const string path = (filesystem::temp_directory_path() / ("simple_vector_test_"s + to_string(getpid()) + ".bin"s)).string();
+
+    SimpleVector<int> numbers = GenerateVector(100001);
+    Save(numbers, path);
+    {
+        MmapView<int> view = OpenMapped<int>(path, MappedVerify::CHECKSUM);
+        assert(view.GetSize() == numbers.GetSize());
+        assert(equal(view.begin(), view.end(), numbers.begin(), numbers.end()));
+        assert(view[100000] == 100001 && view.At(0) == 1);
+        assert(reinterpret_cast<uintptr_t>(view.begin()) % alignof(int) == 0);
+        assert(view.ToSimpleVector() == numbers);
+
+        // Перемещенное представление пусто
+        MmapView<int> moved_view = move(view);
+        assert(view.IsEmpty() && view.begin() == view.end() && view.ToSimpleVector().IsEmpty());
+        assert(moved_view.GetSize() == numbers.GetSize());
+        view = move(moved_view);
+        assert(moved_view.IsEmpty() && moved_view.GetSize() == 0 && view[100000] == 100001);
+
+        // Другой тип элементов отвергается по заголовку
+        bool rejected = false;
+        try {
+            OpenMapped<double>(path);
+        } catch (const runtime_error&) {
+            rejected = true;
+        }
+        assert(rejected);
+    }
+
+    // Поврежденные данные обнаруживаются контрольной суммой
+    {
+        fstream file(path, ios::in | ios::out | ios::binary);
+        file.seekp(1000);
+        file.put('\x7f');
+    }
+    MmapView<int> corrupted = OpenMapped<int>(path);
+    bool mismatch = false;
+    try {
+        corrupted.Verify();
+    } catch (const runtime_error&) {
+        mismatch = true;
+    }
+    assert(mismatch);
+
+    SimpleVector<Point3> points = { { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f } };
+    Save(points, path);
+    MmapView<Point3> mapped_points = OpenMapped<Point3>(path, MappedVerify::CHECKSUM);
+    assert(reinterpret_cast<uintptr_t>(mapped_points.begin()) % 16 == 0 && mapped_points[1].y == 5.0f);
+
+    Save(SimpleVector<int>(), path);
+    assert(OpenMapped<int>(path, MappedVerify::CHECKSUM).IsEmpty());
+
+    bool missing = false;
+    try {
+        OpenMapped<int>(path + ".missing"s);
+    } catch (const system_error&) {
+        missing = true;
+    }
+    assert(missing);
+    filesystem::remove(path);
+    cout << "Done!"s << endl << endl;
+}
+
+// Тривиальный элемент, размер которого не делит CHUNK_BYTES и не кратен 8 байтам
+struct Triple {
+    int a, b, c;
+};
+
+bool operator==(const Triple& lhs, const Triple& rhs) {
+    return lhs.a == rhs.a && lhs.b == rhs.b && lhs.c == rhs.c;
+}
+
+void TestStreamSerialization() {
+    cout << "Test WriteTo and ReadFrom"s << endl;
+    // Больше одной части чтения: тривиальные элементы читаются в хранилище несколькими кусками
+    SimpleVector<int> numbers = GenerateVector(300001);
+    SimpleVector<string> words = { "alpha"s, ""s, string(100000, 'x'), "omega"s };
+
+    stringstream stream;
+    WriteTo(numbers, stream);
+    WriteTo(words, stream);
+    WriteTo(SimpleVector<int>(), stream);
+    SimpleVector<int> read_numbers;
+    SimpleVector<string> read_words;
+    SimpleVector<int> read_empty = { 1, 2, 3 };
+    ReadFrom(stream, read_numbers);
+    ReadFrom(stream, read_words);
+    ReadFrom(stream, read_empty);
+    assert(read_numbers == numbers && read_numbers.GetCapacity() == numbers.GetSize());
+    assert(read_words == words);
+    assert(read_empty.IsEmpty());
+    assert(stream.peek() == char_traits<char>::eof());
+
+    // Части чтения 12-байтовых элементов кратны 8 байтам, и контрольная сумма совпадает с записанной
+    SimpleVector<Triple> triples(200000);
+    for (size_t i = 0; i < triples.GetSize(); ++i) {
+        triples[i] = { static_cast<int>(i), static_cast<int>(i * 3), -static_cast<int>(i) };
+    }
+    stringstream triple_stream;
+    WriteTo(triples, triple_stream);
+    SimpleVector<Triple> read_triples;
+    ReadFrom(triple_stream, read_triples);
+    assert(read_triples == triples);
+
+    // Тривиальные элементы записываются в том же формате, что и Save
+    const string path = (filesystem::temp_directory_path() / ("simple_vector_stream_"s + to_string(getpid()) + ".bin"s)).string();
+    {
+        ofstream file(path, ios::binary);
+        WriteTo(numbers, file);
+    }
+    assert(OpenMapped<int>(path, MappedVerify::CHECKSUM).ToSimpleVector() == numbers);
+    filesystem::remove(path);
+
+    // Через канал: писатель блокируется, пока читатель не освободит буфер канала
+    int fds[2];
+    assert(pipe(fds) == 0);
+    thread writer([&] {
+        WriteTo(numbers, fds[1]);
+        WriteTo(words, fds[1]);
+        close(fds[1]);
+    });
+    SimpleVector<int> piped_numbers;
+    SimpleVector<string> piped_words;
+    ReadFrom(fds[0], piped_numbers);
+    ReadFrom(fds[0], piped_words);
+    writer.join();
+    close(fds[0]);
+    assert(piped_numbers == numbers && piped_words == words);
+
+    const auto fails = [](const string& bytes, auto items) {
+        istringstream in(bytes);
+        try {
+            ReadFrom(in, items);
+        } catch (const runtime_error&) {
+            return items.IsEmpty();
+        }
+        return false;
+    };
+    ostringstream out;
+    WriteTo(words, out);
+    const string encoded_words = out.str();
+    assert(fails(encoded_words.substr(0, encoded_words.size() - 10), SimpleVector<string>()));
+    assert(fails(encoded_words, SimpleVector<int>()));
+    out.str(""s);
+    WriteTo(numbers, out);
+    string encoded_numbers = out.str();
+    assert(fails(encoded_numbers, SimpleVector<string>()));
+    encoded_numbers[1000] ^= 1;
+    assert(fails(encoded_numbers, SimpleVector<int>{ 7 }));
+    cout << "Done!"s << endl << endl;
+}
+
+void TestShrinkToFit() {
+    cout << "Test ShrinkToFit and shrinking growth policy"s << endl;
+    SimpleVector<int> numbers = GenerateVector(1000);
+    numbers.Resize(10);
+    assert(numbers.GetCapacity() == 1000);
+    numbers.ShrinkToFit();
+    assert(numbers.GetCapacity() == 10 && numbers[9] == 10);
+    numbers.Clear();
+    numbers.ShrinkToFit();
+    assert(numbers.GetCapacity() == 0 && numbers.begin() == nullptr);
+
+    // Удаленные элементы разрушаются сразу, а не при освобождении буфера
+    auto shared = make_shared<int>(42);
+    SimpleVector<shared_ptr<int>> owners(10, shared);
+    owners.Resize(3);
+    owners.PopBack();
+    owners.Erase(owners.begin());
+    assert(shared.use_count() == 2);
+    owners.ShrinkToFit();
+    assert(owners.GetCapacity() == 1 && *owners[0] == 42);
+
+    using Shrinking = SimpleVector<int, std::allocator<int>, ShrinkingGrowth<DoublingGrowth, 4, 64>, CountingVectorStats<int>>;
+    Shrinking v;
+    for (int i = 0; i < 1000; ++i) {
+        v.PushBack(i);
+    }
+    assert(v.GetCapacity() == 1024);
+    while (v.GetSize() > 256) {
+        v.PopBack();
+    }
+    assert(v.GetCapacity() == 1024);
+    v.PopBack();
+    assert(v.GetCapacity() == 510 && v[254] == 254);
+    // На границе вставки и удаления не вызывают переездов
+    for (int i = 0; i < 100; ++i) {
+        v.PushBack(i);
+        v.PopBack();
+    }
+    assert(v.GetCapacity() == 510 && v.GetStats().shrinks == 1);
+
+    auto it = v.Erase(v.begin() + 10);
+    while (v.GetSize() > 126) {
+        it = v.Erase(v.begin() + 10);
+    }
+    assert(v.GetCapacity() == 252 && it == v.begin() + 10 && *it == 139 && v.GetStats().shrinks == 2);
+    v.Resize(20);
+    assert(v.GetCapacity() == 40 && v[9] == 9 && v[10] == 139);
+    v.Clear();
+    assert(v.GetCapacity() == 16 && v.GetStats().shrinks == 4);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestBulkErase() {
+    cout << "Test Erase(range), EraseIf, Remove and UnorderedErase"s << endl;
+    SimpleVector<int> numbers = GenerateVector(10);
+    auto it = numbers.Erase(numbers.begin() + 2, numbers.begin() + 5);
+    assert(*it == 6 && (numbers == SimpleVector<int>{ 1, 2, 6, 7, 8, 9, 10 }));
+    it = numbers.Erase(numbers.begin() + 3, numbers.begin() + 3);
+    assert(*it == 7 && numbers.GetSize() == 7);
+    it = numbers.Erase(numbers.begin() + 4, numbers.end());
+    assert(it == numbers.end() && (numbers == SimpleVector<int>{ 1, 2, 6, 7 }));
+
+    SimpleVector<string> words = { "a"s, "bb"s, "c"s, "dd"s, "e"s };
+    auto word = words.Erase(words.begin(), words.begin() + 2);
+    assert(*word == "c"s && (words == SimpleVector<string>{ "c"s, "dd"s, "e"s }));
+
+    // Один проход вместо сдвига хвоста на каждое удаление
+    numbers = GenerateVector(100000);
+    assert(numbers.EraseIf([](int x) { return x % 3 == 0; }) == 33333);
+    assert(numbers.GetSize() == 66667 && numbers[0] == 1 && numbers[1] == 2 && numbers[2] == 4);
+    assert(numbers.EraseIf([](int) { return false; }) == 0 && numbers.GetSize() == 66667);
+
+    words = { "x"s, "y"s, "x"s, "z"s, "x"s };
+    assert(words.Remove(words[0]) == 3 && (words == SimpleVector<string>{ "y"s, "z"s }));
+    SimpleVector<unique_ptr<int>> owners;
+    for (int i = 0; i < 6; ++i) {
+        owners.PushBack(make_unique<int>(i));
+    }
+    assert(owners.EraseIf([](const unique_ptr<int>& p) { return *p % 2 == 1; }) == 3);
+    assert(owners.GetSize() == 3 && *owners[0] == 0 && *owners[1] == 2 && *owners[2] == 4);
+
+    // Исключение в предикате не оставляет пропусков
+    numbers = { 1, 2, 3, 4, 5, 6 };
+    try {
+        numbers.EraseIf([](int x) {
+            if (x == 5) {
+                throw runtime_error("stop"s);
+            }
+            return x % 2 == 0;
+        });
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    assert((numbers == SimpleVector<int>{ 1, 3, 5, 6 }));
+
+    it = numbers.UnorderedErase(numbers.begin());
+    assert(*it == 6 && (numbers == SimpleVector<int>{ 6, 3, 5 }));
+    it = numbers.UnorderedErase(numbers.end() - 1);
+    assert(it == numbers.end() && (numbers == SimpleVector<int>{ 6, 3 }));
+    words = { "a"s, "b"s, "c"s };
+    words.UnorderedErase(words.begin() + 1);
+    assert((words == SimpleVector<string>{ "a"s, "c"s }));
+    cout << "Done!"s << endl << endl;
+}
+
+template <typename Layout>
+void CheckFlatSetLayout() {
+    FlatSet<int, less<int>, Layout> set = { 5, 1, 3, 1, 9 };
+    assert(set.GetSize() == 4 && (set.GetKeys() == SimpleVector<int>{ 1, 3, 5, 9 }));
+    assert(set.Contains(3) && !set.Contains(4) && set.Count(9) == 1);
+    assert(*set.LowerBound(4) == 5 && *set.UpperBound(5) == 9 && set.LowerBound(10) == set.end());
+    assert(set.Insert(4).second && !set.Insert(4).second && *set.Find(4) == 4);
+    assert(set.Erase(1) == 1 && set.Erase(1) == 0 && *set.begin() == 3);
+
+    // Сверка со std::set на всех размерах дерева Эйтцингера до 300 ключей
+    std::set<int> expected;
+    FlatSet<int, less<int>, Layout> checked;
+    for (int i = 0; i < 300; ++i) {
+        const int key = (i * 7919) % 601;
+        expected.insert(key);
+        checked.Insert(key);
+        for (int probe = -1; probe <= 602; probe += 3) {
+            const auto lower = expected.lower_bound(probe);
+            const auto found = checked.LowerBound(probe);
+            assert((lower == expected.end()) == (found == checked.end()));
+            assert(lower == expected.end() || *lower == *found);
+        }
+    }
+
+    SimpleVector<int> batch = GenerateVector(1000);
+    reverse(batch.begin(), batch.end());
+    batch.PushBack(500);
+    FlatSet<int, greater<int>, Layout> descending;
+    descending.InsertRange(batch);
+    descending.InsertRange(GenerateVector(1500));
+    assert(descending.GetSize() == 1500 && *descending.begin() == 1500 && *descending.Find(700) == 700);
+    assert(is_sorted(descending.begin(), descending.end(), greater<int>()));
+}
+
+template <typename Layout>
+void CheckFlatMapLayout() {
+    FlatMap<string, int, less<string>, Layout> map = { { "b"s, 2 }, { "a"s, 1 }, { "c"s, 3 }, { "a"s, 10 } };
+    assert(map.GetSize() == 3 && map.At("a"s) == 1 && map["c"s] == 3);
+    map["d"s] = 4;
+    assert(map.GetSize() == 4 && map.Find("d"s).GetValue() == 4);
+    assert(!map.Insert("b"s, 20).second && map.At("b"s) == 2);
+    assert(!map.InsertOrAssign("b"s, 20).second && map.At("b"s) == 20);
+    assert(map.TryEmplace("e"s, 5).second && map.Find("z"s) == map.end());
+    for (auto [key, value] : map) {
+        value *= 2;
+    }
+    assert(map.At("a"s) == 2 && map.At("e"s) == 10);
+    assert(map.LowerBound("bb"s)->first == "c"s && map.UpperBound("c"s)->second == 8);
+    assert(map.Erase("a"s) == 1 && map.Erase("a"s) == 0 && map.begin()->first == "b"s);
+    bool missing = false;
+    try {
+        map.At("a"s);
+    } catch (const out_of_range&) {
+        missing = true;
+    }
+    assert(missing);
+
+    vector<pair<string, int>> batch = { { "y"s, 25 }, { "b"s, -1 }, { "x"s, 24 }, { "y"s, -1 } };
+    map.InsertRange(batch);
+    assert(map.GetSize() == 6 && map.At("b"s) == 40 && map.At("y"s) == 25 && (map.end() - 1)->first == "y"s);
+    const auto& const_map = map;
+    assert(const_map.Find("x"s).GetIndex() == 4 && is_sorted(const_map.GetKeys().begin(), const_map.GetKeys().end()));
+    map.Erase(map.Find("x"s));
+    map.Clear();
+    assert(map.IsEmpty() && map.Find("y"s) == map.end());
+}
+
+// Значение с перемещением без noexcept и копированием, выбрасывающим исключение после
+// copies_left удачных копий (-1 - без ограничения)
+struct FragileValue {
+    static inline int copies_left = -1;
+    int value = 0;
+    FragileValue(int v)
+        : value(v) {
+    }
+    FragileValue(const FragileValue& other)
+        : value(other.value) {
+        if (copies_left == 0) {
+            throw runtime_error("copy failed"s);
+        }
+        if (copies_left > 0) {
+            --copies_left;
+        }
+    }
+    FragileValue(FragileValue&& other)
+        : value(other.value) {
+    }
+    FragileValue& operator=(const FragileValue&) = default;
+    FragileValue& operator=(FragileValue&&) = default;
+};
+
+void TestFlatContainers() {
+    cout << "Test FlatSet and FlatMap"s << endl;
+    CheckFlatSetLayout<SortedLayout>();
+    CheckFlatSetLayout<EytzingerLayout>();
+    CheckFlatMapLayout<SortedLayout>();
+    CheckFlatMapLayout<EytzingerLayout>();
+
+    // Ошибка копирования значения при слиянии не портит ключи: старые пары копируются целиком
+    FlatMap<string, FragileValue> map;
+    map.Insert("a"s, FragileValue(1));
+    map.Insert("c"s, FragileValue(3));
+    const vector<pair<string, FragileValue>> added = { { "b"s, FragileValue(2) } };
+    FragileValue::copies_left = 1;
+    try {
+        map.InsertRange(added);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    FragileValue::copies_left = -1;
+    assert(map.GetSize() == 2 && map.GetKeys()[0] == "a"s && map.At("a"s).value == 1 && map.At("c"s).value == 3);
+    map.InsertRange(added);
+    assert(map.GetSize() == 3 && map.At("b"s).value == 2);
+    cout << "Done!"s << endl << endl;
+}
+
+// Этап конвейера получает кадр без копирования
+int SumFrame(SimpleVectorView<const int> frame) {
+    int sum = 0;
+    for (int x : frame) {
+        sum += x;
+    }
+    return sum;
+}
+
+void TestSimpleVectorView() {
+    cout << "Test SimpleVectorView"s << endl;
+    SimpleVector<int> numbers = GenerateVector(10);
+    assert(SumFrame(numbers) == 55);
+    const SimpleVector<int>& const_numbers = numbers;
+    SimpleVectorView<const int> all = const_numbers;
+    assert(all.GetSize() == 10 && all.GetData() == numbers.cbegin() && all[9] == 10);
+
+    // Подпредставления указывают в тот же буфер
+    SimpleVectorView<int> middle = MakeView(numbers).Subview(2, 3);
+    assert(middle.GetSize() == 3 && middle[0] == 3 && middle.At(2) == 5);
+    middle[1] = 40;
+    assert(numbers[3] == 40 && SumFrame(middle) == 48);
+    assert(middle.Subview(1).GetSize() == 2 && middle.Subview(1)[0] == 40);
+    assert(all.Subview(8, 100).GetSize() == 2 && all.Subview(10).IsEmpty());
+    try {
+        middle.At(3);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    try {
+        all.Subview(11);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // Пара указателей, сравнение с вектором и между представлениями
+    SimpleVectorView<const int> pair_view(numbers.cbegin() + 2, numbers.cbegin() + 5);
+    assert(pair_view == middle && !(pair_view != middle));
+    SimpleVector<int> expected = { 3, 40, 5 };
+    assert(pair_view == expected && expected == middle);
+    assert(all.Subview(0, 2) < middle && middle > all.Subview(0, 3) && middle <= expected && middle >= expected);
+    assert((middle.ToSimpleVector() == expected));
+    assert(SimpleVectorView<int>().IsEmpty() && SimpleVectorView<int>() == SimpleVectorView<int>());
+    int* data = numbers.begin();
+    SimpleVectorView<int> empty_view(data, 0);
+    SimpleVectorView<const int> const_pair(data, data + 3);
+    assert(empty_view.IsEmpty() && empty_view.GetData() == data && const_pair.GetSize() == 3);
+
+    SimpleVector<string> words = { "a"s, "bb"s, "c"s };
+    SimpleVectorView<string> tail = MakeView(words).Subview(1);
+    tail[0] += "b"s;
+    SimpleVector<string> expected_words = { "bbb"s, "c"s };
+    assert(words[1] == "bbb"s && words < tail && tail == expected_words);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSoaVector() {
+    cout << "Test SoaVector"s << endl;
+    SoaVector<int, string, double> records;
+    for (int i = 0; i < 100; ++i) {
+        records.PushBack(i, to_string(i), i * 0.5);
+    }
+    assert(records.GetSize() == 100 && records.GetCapacity() >= 100);
+
+    // Столбцы - непрерывные массивы одного поля
+    auto ids = records.Column<0>();
+    assert(ids.GetSize() == 100 && accumulate(ids.begin(), ids.end(), 0) == 4950);
+    assert(records.Column<1>()[42] == "42"s && records.Column<2>()[42] == 21.0);
+
+    // Прокси строки: поля по номеру, структурное связывание дает ссылки
+    auto row = records[7];
+    assert(row.Get<0>() == 7 && row.Get<1>() == "7"s && row.GetIndex() == 7);
+    auto [id, name, weight] = records[8];
+    id = -8;
+    name += "!"s;
+    assert(records.Column<0>()[8] == -8 && records.Column<1>()[8] == "8!"s && weight == 4.0);
+    records[9] = make_tuple(90, "ninety"s, 45.0);
+    assert((tuple<int, string, double>(records.At(9)) == make_tuple(90, "ninety"s, 45.0)));
+    records[10] = records[9];
+    assert(records[10].Get<1>() == "ninety"s && records[9].Get<1>() == "ninety"s);
+    try {
+        records.At(100);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // Insert и Erase сдвигают все столбцы одинаково
+    records.Insert(0, -1, "first"s, -0.5);
+    records.Insert(records.GetSize(), 1000, "last"s, 500.0);
+    records.Insert(50, 4949, string(100, 'x'), 1.0);
+    assert(records.GetSize() == 103);
+    assert(records[0].Get<1>() == "first"s && records[1].Get<0>() == 0 && records[102].Get<0>() == 1000);
+    assert(records[50].Get<0>() == 4949 && records[50].Get<1>() == string(100, 'x') && records[51].Get<1>() == "49"s);
+    records.Erase(50);
+    records.Erase(0);
+    records.Erase(10, 20);
+    assert(records.GetSize() == 91);
+    size_t in_sync = 0;
+    for (size_t i = 0; i < records.GetSize(); ++i) {
+        auto [value, text, half] = records[i];
+        if (text == to_string(value)) {
+            assert(half == value * 0.5);
+            ++in_sync;
+        }
+    }
+    assert(in_sync == 88);
+    assert(records[10].Get<0>() == 20 && records[10].Get<1>() == "20"s);
+
+    // PushBack со ссылкой на элемент самого вектора при перевыделении
+    SoaVector<string, int> names;
+    names.PushBack("a"s, 1);
+    while (names.GetSize() < names.GetCapacity()) {
+        names.PushBack("b"s, 2);
+    }
+    names.PushBack(names.Column<0>()[0], names.Column<1>()[0]);
+    assert(names[names.GetSize() - 1].Get<0>() == "a"s && names[names.GetSize() - 1].Get<1>() == 1);
+
+    // Копирование, перемещение, некопируемые поля
+    SoaVector<int, string, double> copy = records;
+    assert(copy.GetSize() == records.GetSize() && copy.Column<1>()[10] == "20"s);
+    SoaVector<int, string, double> moved = move(copy);
+    assert(moved.GetSize() == records.GetSize() && copy.IsEmpty());
+    SoaVector<unique_ptr<int>, int> owners(3);
+    owners.PushBack(make_unique<int>(5), 5);
+    owners.Insert(1, make_unique<int>(1), 1);
+    assert(owners.GetSize() == 5 && *owners[1].Get<0>() == 1 && *owners[4].Get<0>() == 5 && !owners[0].Get<0>());
+    owners.Erase(0, 2);
+    assert(owners.GetSize() == 3 && *owners[2].Get<0>() == 5);
+    owners.Resize(1);
+    owners.PopBack();
+    assert(owners.IsEmpty());
+    cout << "Done!"s << endl << endl;
+}
+
+// Таблица строится при компиляции и встраивается в двоичный файл
+constexpr StaticVector<int, 16> MakeSquares() {
+    StaticVector<int, 16> squares;
+    for (int i = 0; i < 10; ++i) {
+        squares.PushBack(i * i);
+    }
+    squares.Insert(squares.begin(), -1);
+    squares.Erase(squares.begin() + 1);
+    return squares;
+}
+
+constexpr StaticVector<int, 16> SQUARES = MakeSquares();
+static_assert(SQUARES.GetSize() == 10 && SQUARES[0] == -1 && SQUARES[9] == 81);
+static_assert(SQUARES == MakeSquares() && StaticVector<int, 16>{ 1, 2 } < StaticVector<int, 16>{ 1, 3 });
+
+void TestStaticVector() {
+    cout << "Test StaticVector"s << endl;
+    StaticVector<int, 4> numbers = { 1, 2, 3 };
+    numbers.PushBack(4);
+    assert(numbers.GetSize() == 4 && numbers.GetCapacity() == 4 && numbers[3] == 4);
+    try {
+        numbers.PushBack(5);
+        assert(false);
+    } catch (const length_error&) {
+    }
+    try {
+        numbers.Insert(numbers.begin(), 0);
+        assert(false);
+    } catch (const length_error&) {
+    }
+    assert((numbers == StaticVector<int, 4>{ 1, 2, 3, 4 }));
+    numbers.Erase(numbers.begin() + 1, numbers.begin() + 3);
+    numbers.Insert(numbers.begin() + 1, 7);
+    assert((numbers == StaticVector<int, 4>{ 1, 7, 4 }));
+    numbers.Resize(1);
+    assert(numbers.GetSize() == 1 && numbers.At(0) == 1);
+    try {
+        numbers.At(1);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // Нетривиальные элементы конструируются и разрушаются в неинициализированном буфере
+    StaticVector<string, 8> words = { "a"s, "b"s };
+    words.Insert(words.begin(), words[1]);
+    words.EmplaceBack(3, 'c');
+    assert((words == StaticVector<string, 8>{ "b"s, "a"s, "b"s, "ccc"s }));
+    StaticVector<string, 8> other(2, "x"s);
+    words.swap(other);
+    assert(words.GetSize() == 2 && other.GetSize() == 4 && other[3] == "ccc"s && words[1] == "x"s);
+    StaticVector<string, 8> copy = other;
+    StaticVector<string, 8> moved = move(other);
+    assert(copy == moved && other.IsEmpty() && moved < words);
+    words = copy;
+    assert(words == copy);
+
+    StaticVector<X, 5> items(3);
+    items.PushBack(X(7));
+    items.Insert(items.begin(), X(9));
+    assert(items.GetSize() == 5 && items[0].GetX() == 9 && items[4].GetX() == 7 && items[1].GetX() == 5);
+    items.Erase(items.begin());
+    StaticVector<X, 5> moved_items(move(items));
+    assert(moved_items.GetSize() == 4 && moved_items[3].GetX() == 7 && items.IsEmpty());
+    cout << "Done!"s << endl << endl;
+}
+
+void TestPoolAllocator() {
+    cout << "Test PoolAllocator"s << endl;
+    using PooledVector = SimpleVector<int, PoolAllocator<int>>;
+    buffer_pool::TrimThreadCache();
+    const buffer_pool::PoolStats before = buffer_pool::GetThreadStats();
+
+    // Буферы разрушенных векторов переиспользуются следующими векторами близкой емкости
+    for (int request = 0; request < 100; ++request) {
+        PooledVector items;
+        for (int i = 0; i < 1000; ++i) {
+            items.PushBack(i);
+        }
+        assert(items[999] == 999);
+    }
+    const buffer_pool::PoolStats after = buffer_pool::GetThreadStats();
+    const size_t allocations = after.allocations - before.allocations;
+    const size_t system_allocations = after.system_allocations - before.system_allocations;
+    assert(allocations == 100 * 11 && system_allocations <= 11);
+    assert(after.reuses - before.reuses == allocations - system_allocations && after.cached_blocks > 0);
+
+    // Нетривиальные элементы и вектор из кэша другой емкости
+    SimpleVector<string, PoolAllocator<string>> words(3, "pooled"s);
+    words.Insert(words.begin(), "first"s);
+    assert(words.GetSize() == 4 && words[0] == "first"s && words[3] == "pooled"s);
+
+    // Ограничение и явная очистка кэша
+    buffer_pool::SetThreadCacheLimit(4096);
+    assert(buffer_pool::GetThreadStats().cached_bytes <= 4096);
+    {
+        PooledVector large(100000, 1);
+        assert(large[99999] == 1);
+    }
+    assert(buffer_pool::GetThreadStats().cached_bytes <= 4096);
+    buffer_pool::TrimThreadCache();
+    assert(buffer_pool::GetThreadStats().cached_bytes == 0 && buffer_pool::GetThreadStats().cached_blocks == 0);
+    buffer_pool::SetThreadCacheLimit(buffer_pool::DEFAULT_CACHE_LIMIT);
+
+    // Буфер, освобожденный в другом потоке, попадает в кэш этого потока
+    PooledVector shared(100, 7);
+    thread([&shared] {
+        PooledVector local = move(shared);
+        assert(local.GetSize() == 100);
+        local = PooledVector();
+        assert(buffer_pool::GetThreadStats().cached_blocks == 1);
+    }).join();
+    assert(shared.IsEmpty());
+
+    // Блок, выделенный после разрушения кэша потока (из деструктора thread_local), имеет
+    // размер класса и может быть выдан из кэша другого потока под запрос того же класса
+    int* late = nullptr;
+    thread([&late] {
+        struct LateAllocation {
+            int** out;
+            ~LateAllocation() {
+                *out = PoolAllocator<int>().allocate(100);
+            }
+        };
+        thread_local LateAllocation allocation{&late};
+        PooledVector warm_up(1, 1);  // Кэш потока создается позже и разрушается раньше
+    }).join();
+    assert(late != nullptr);
+    PoolAllocator<int>().deallocate(late, 100);
+    int* reused = PoolAllocator<int>().allocate(128);
+    assert(reused == late);
+    fill(reused, reused + 128, 1);
+    assert(reused[127] == 1);
+    PoolAllocator<int>().deallocate(reused, 128);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestBitVector() {
+    cout << "Test BitVector"s << endl;
+    BitVector<> bits;
+    vector<bool> expected;
+    for (size_t i = 0; i < 300; ++i) {
+        const bool value = i % 3 == 0 || i % 7 == 0;
+        bits.PushBack(value);
+        expected.push_back(value);
+    }
+    assert(bits.GetSize() == 300 && bits.GetWords().GetSize() == 5);
+    assert(equal(bits.begin(), bits.end(), expected.begin(), expected.end()));
+    assert(bits.Count() == static_cast<size_t>(count(expected.begin(), expected.end(), true)));
+
+    // Прокси ссылки
+    bits[1] = true;
+    bits[0] = bits[2];
+    bits.Flip(4);
+    expected[1] = true;
+    expected[0] = expected[2];
+    expected[4] = !expected[4];
+    assert(bits[1] && !bits[0] && bits.At(4) == expected[4]);
+    try {
+        bits.At(300);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // Вставка и удаление со сдвигом через границы слов
+    const size_t positions[] = { 0, 1, 63, 64, 65, 127, 200, 302 };
+    for (size_t pos : positions) {
+        bits.Insert(pos, pos % 2 == 0);
+        expected.insert(expected.begin() + static_cast<ptrdiff_t>(pos), pos % 2 == 0);
+    }
+    assert(equal(bits.begin(), bits.end(), expected.begin(), expected.end()));
+    bits.Erase(5);
+    expected.erase(expected.begin() + 5);
+    bits.Erase(10, 150);
+    expected.erase(expected.begin() + 10, expected.begin() + 150);
+    bits.Erase(0, 1);
+    expected.erase(expected.begin());
+    bits.Erase(bits.GetSize() - 70, bits.GetSize());
+    expected.erase(expected.end() - 70, expected.end());
+    assert(equal(bits.begin(), bits.end(), expected.begin(), expected.end()));
+    assert(bits.Count() == static_cast<size_t>(count(expected.begin(), expected.end(), true)));
+
+    // Поиск установленных битов
+    BitVector<> sparse(1000);
+    assert(sparse.FindFirst() == BitVector<>::npos && sparse.None());
+    const size_t set_bits[] = { 3, 64, 65, 511, 999 };
+    for (size_t index : set_bits) {
+        sparse.Set(index);
+    }
+    vector<size_t> found;
+    for (size_t i = sparse.FindFirst(); i != BitVector<>::npos; i = sparse.FindNext(i)) {
+        found.push_back(i);
+    }
+    assert((found == vector<size_t>{ 3, 64, 65, 511, 999 }) && sparse.Count() == 5);
+    vector<size_t> visited;
+    sparse.ForEachSetBit([&visited](size_t i) {
+        visited.push_back(i);
+    });
+    assert(visited == found);
+
+    // Побитовые операции, сравнение и хвост за концом
+    BitVector<> all(130, true);
+    assert(all.All() && all.Count() == 130);
+    all.Resize(200, false);
+    all.Resize(260, true);
+    assert(all.Count() == 190 && !all[150] && all[259]);
+    all.Resize(131);
+    assert(all.Count() == 130 && all != BitVector<>(130, true));
+    BitVector<> a(131);
+    BitVector<> b(131);
+    a.Set(0);
+    a.Set(130);
+    b.Set(130);
+    b.Set(64);
+    assert((a & b).Count() == 1 && (a | b).Count() == 3 && (a ^ b).Count() == 2);
+    BitVector<> flipped = a;
+    flipped.Flip();
+    assert(flipped.Count() == 129 && (flipped ^ a) == BitVector<>(131, true));
+    assert((BitVector<>{ true, false, true } == BitVector<>{ true, false, true }));
+    assert((BitVector<>{ true, false } != BitVector<>{ true, false, false }));
+    a.Fill(true);
+    assert(a == BitVector<>(131, true));
+    a.PopBack();
+    a.PushBack(false);
+    assert(a.Count() == 130 && !a[130]);
+    cout << "Done!"s << endl << endl;
+}
+
 int main() {
     TestTemporaryObjConstructor();
     TestTemporaryObjOperator();
@@ -159,5 +1553,29 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestRawStorage();
+    TestPmrAllocator();
+    TestSmallSimpleVector();
+    TestTriviallyRelocatable();
+    TestEmplaceAndRangeInsert();
+    TestVectorStats();
+    TestGrowthPolicy();
+    TestMmapAllocator();
+    TestSimdKernels();
+    TestParallelOperations();
+    TestConcurrentSimpleVector();
+    TestSegmentedSimpleVector();
+    TestIncrementalSimpleVector();
+    TestSharedSimpleVector();
+    TestMappedFile();
+    TestStreamSerialization();
+    TestShrinkToFit();
+    TestBulkErase();
+    TestFlatContainers();
+    TestSimpleVectorView();
+    TestSoaVector();
+    TestStaticVector();
+    TestPoolAllocator();
+    TestBitVector();
     return 0;
 }
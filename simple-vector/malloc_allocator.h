@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Распределитель на основе malloc/free. В отличие от std::allocator умеет изменять размер
+// блока через realloc (метод reallocate), что позволяет SimpleVector расти на месте
+// для тривиально перемещаемых типов без копирования элементов
+template <typename Type>
+class MallocAllocator
+{
+    static_assert(alignof(Type) <= alignof(std::max_align_t), "malloc does not support over-aligned types");
+
+public:
+    using value_type = Type;
+    using is_always_equal = std::true_type;
+
+    MallocAllocator() noexcept = default;
+
+    template <typename Other>
+    MallocAllocator(const MallocAllocator<Other>&) noexcept
+    {
+    }
+
+    Type* allocate(size_t size)
+    {
+        return static_cast<Type*>(CheckedResult(std::malloc(BytesFor(size))));
+    }
+
+    void deallocate(Type* ptr, size_t) noexcept
+    {
+        std::free(ptr);
+    }
+
+    // Изменяет размер блока ptr с old_size до new_size элементов, сохраняя содержимое.
+    // Вызывается только для тривиально перемещаемых типов
+    Type* reallocate(Type* ptr, size_t /*old_size*/, size_t new_size)
+    {
+        return static_cast<Type*>(CheckedResult(std::realloc(ptr, BytesFor(new_size))));
+    }
+
+private:
+    static size_t BytesFor(size_t size)
+    {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type))
+        {
+            throw std::bad_array_new_length();
+        }
+        return size * sizeof(Type);
+    }
+
+    static void* CheckedResult(void* ptr)
+    {
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+};
+
+template <typename Lhs, typename Rhs>
+inline bool operator==(const MallocAllocator<Lhs>&, const MallocAllocator<Rhs>&) noexcept
+{
+    return true;
+}
+
+template <typename Lhs, typename Rhs>
+inline bool operator!=(const MallocAllocator<Lhs>&, const MallocAllocator<Rhs>&) noexcept
+{
+    return false;
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Распределитель для очень больших SimpleVector (Linux).
+// Блоки меньше ThresholdBytes берутся у malloc, блоки от ThresholdBytes - анонимным mmap.
+// reallocate() для больших блоков выполняется через mremap(MREMAP_MAYMOVE): ядро переносит
+// отображение страниц вместо копирования данных, поэтому рост вектора тривиально перемещаемых
+// элементов не требует второго буфера и копирования всего массива.
+// При HugePages = true для больших блоков вызывается madvise(MADV_HUGEPAGE), что уменьшает
+// промахи TLB при проходах по массиву.
+// На системах без mremap большие блоки выделяются через malloc
+template <typename Type, size_t ThresholdBytes = 1 << 20, bool HugePages = false>
+class MmapAllocator
+{
+    static_assert(alignof(Type) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+
+public:
+    using value_type = Type;
+    using is_always_equal = std::true_type;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = MmapAllocator<Other, ThresholdBytes, HugePages>;
+    };
+
+    MmapAllocator() noexcept = default;
+
+    template <typename Other>
+    MmapAllocator(const MmapAllocator<Other, ThresholdBytes, HugePages>&) noexcept
+    {
+    }
+
+    Type* allocate(size_t size)
+    {
+        const size_t bytes = BytesFor(size);
+        if (!IsMapped(bytes))
+        {
+            return static_cast<Type*>(CheckedMalloc(std::malloc(bytes)));
+        }
+        return static_cast<Type*>(Map(bytes));
+    }
+
+    void deallocate(Type* ptr, size_t size) noexcept
+    {
+        const size_t bytes = size * sizeof(Type);
+        if (!IsMapped(bytes))
+        {
+            std::free(ptr);
+            return;
+        }
+        Unmap(ptr, bytes);
+    }
+
+    // Изменяет размер блока с old_size до new_size элементов, сохраняя содержимое.
+    // Вызывается только для тривиально перемещаемых типов
+    Type* reallocate(Type* ptr, size_t old_size, size_t new_size)
+    {
+        const size_t old_bytes = old_size * sizeof(Type);
+        const size_t new_bytes = BytesFor(new_size);
+        const bool old_mapped = IsMapped(old_bytes);
+        const bool new_mapped = IsMapped(new_bytes);
+
+        if (!old_mapped && !new_mapped)
+        {
+            return static_cast<Type*>(CheckedMalloc(std::realloc(ptr, new_bytes)));
+        }
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+        if (old_mapped && new_mapped)
+        {
+            void* result = ::mremap(ptr, RoundToPages(old_bytes), RoundToPages(new_bytes), MREMAP_MAYMOVE);
+            if (result == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+            AdviseHugePages(result, RoundToPages(new_bytes));
+            return static_cast<Type*>(result);
+        }
+#endif
+
+        // Блок пересекает порог: переезд между malloc и mmap с копированием
+        Type* result = allocate(new_size);
+        std::memcpy(static_cast<void*>(result), static_cast<const void*>(ptr), std::min(old_bytes, new_bytes));
+        deallocate(ptr, old_size);
+        return result;
+    }
+
+private:
+    static bool IsMapped(size_t bytes) noexcept
+    {
+#if defined(__linux__)
+        return bytes >= ThresholdBytes;
+#else
+        static_cast<void>(bytes);
+        return false;
+#endif
+    }
+
+    static size_t BytesFor(size_t size)
+    {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type))
+        {
+            throw std::bad_array_new_length();
+        }
+        return size * sizeof(Type);
+    }
+
+    static void* CheckedMalloc(void* ptr)
+    {
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+#if defined(__linux__)
+    static size_t RoundToPages(size_t bytes) noexcept
+    {
+        static const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return (bytes + page_size - 1) / page_size * page_size;
+    }
+
+    static void AdviseHugePages([[maybe_unused]] void* ptr, [[maybe_unused]] size_t bytes) noexcept
+    {
+#if defined(MADV_HUGEPAGE)
+        if constexpr (HugePages)
+        {
+            // Подсказка ядру: ошибка (например, THP выключены) не мешает работе
+            static_cast<void>(::madvise(ptr, bytes, MADV_HUGEPAGE));
+        }
+#endif
+    }
+
+    static void* Map(size_t bytes)
+    {
+        const size_t mapped_bytes = RoundToPages(bytes);
+        void* ptr = ::mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        AdviseHugePages(ptr, mapped_bytes);
+        return ptr;
+    }
+
+    static void Unmap(void* ptr, size_t bytes) noexcept
+    {
+        ::munmap(ptr, RoundToPages(bytes));
+    }
+#else
+    static void* Map(size_t bytes)
+    {
+        return CheckedMalloc(std::malloc(bytes));
+    }
+
+    static void Unmap(void* ptr, size_t) noexcept
+    {
+        std::free(ptr);
+    }
+#endif
+};
+
+template <typename Lhs, typename Rhs, size_t ThresholdBytes, bool HugePages>
+inline bool operator==(const MmapAllocator<Lhs, ThresholdBytes, HugePages>&,
+                       const MmapAllocator<Rhs, ThresholdBytes, HugePages>&) noexcept
+{
+    return true;
+}
+
+template <typename Lhs, typename Rhs, size_t ThresholdBytes, bool HugePages>
+inline bool operator!=(const MmapAllocator<Lhs, ThresholdBytes, HugePages>&,
+                       const MmapAllocator<Rhs, ThresholdBytes, HugePages>&) noexcept
+{
+    return false;
+}
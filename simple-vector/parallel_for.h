@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace parallel
+{
+
+// Политика параллельного выполнения для перегрузок SimpleVector:
+//     SimpleVector<int> v(parallel::par, size, value);
+//     SimpleVector<int> copy(parallel::ParallelPolicy{ 8 }, v);
+// Объемы меньше min_chunk_bytes не делятся между потоками: запуск потока дороже самой работы
+struct ParallelPolicy
+{
+    size_t threads = 0;                   // 0 - по числу аппаратных потоков
+    size_t min_chunk_bytes = 1 << 20;
+};
+
+inline constexpr ParallelPolicy par{};
+
+inline size_t HardwareThreads() noexcept
+{
+    static const size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    return threads;
+}
+
+// Количество кусков, на которые стоит разделить обработку bytes байт
+inline size_t ChunkCount(const ParallelPolicy& policy, size_t bytes) noexcept
+{
+    const size_t threads = policy.threads != 0 ? policy.threads : HardwareThreads();
+    const size_t by_size = bytes / std::max<size_t>(policy.min_chunk_bytes, 1);
+    return std::clamp<size_t>(by_size, 1, threads);
+}
+
+// Начало куска chunk при делении [0, size) на chunk_count почти равных непрерывных кусков
+inline size_t ChunkBegin(size_t size, size_t chunk_count, size_t chunk) noexcept
+{
+    return chunk * (size / chunk_count) + std::min(chunk, size % chunk_count);
+}
+
+// Вызывает body(chunk, first, last) для каждого из chunk_count кусков [0, size): куски, кроме
+// последнего, - в отдельных потоках, последний - в вызывающем. Возвращает управление после
+// завершения всех кусков; исключение куска с наименьшим номером пробрасывается вызывающему.
+// Если поток не удалось запустить, оставшиеся куски выполняются в вызывающем потоке
+template <typename Body>
+void ForEachChunk(size_t size, size_t chunk_count, Body&& body)
+{
+    if (chunk_count <= 1)
+    {
+        body(size_t{ 0 }, size_t{ 0 }, size);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(chunk_count);
+    auto run = [&](size_t chunk)
+    {
+        try
+        {
+            body(chunk, ChunkBegin(size, chunk_count, chunk), ChunkBegin(size, chunk_count, chunk + 1));
+        }
+        catch (...)
+        {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(chunk_count - 1);
+    size_t chunk = 0;
+    try
+    {
+        for (; chunk + 1 < chunk_count; ++chunk)
+        {
+            workers.emplace_back(run, chunk);
+        }
+    }
+    catch (const std::system_error&)
+    {
+    }
+    for (; chunk < chunk_count; ++chunk)
+    {
+        run(chunk);
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // namespace parallel
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+// Кэш освобожденных буферов для короткоживущих векторов. Каждый поток держит свои списки
+// свободных блоков по размерным классам (степени двойки от 64 байт до 1 МБ), поэтому повторное
+// выделение буфера близкой емкости не обращается к глобальному распределителю и не конкурирует
+// с другими потоками за его блокировки. Блоки крупнее MAX_BLOCK_BYTES в кэш не попадают.
+// Объем кэша потока ограничен (SetThreadCacheLimit): блок, не поместившийся в лимит,
+// сразу возвращается системе. TrimThreadCache освобождает кэш явно, при завершении потока
+// кэш освобождается автоматически. Блок можно освободить в другом потоке: он попадет в кэш
+// освобождающего потока
+namespace buffer_pool
+{
+
+// Счетчики кэша текущего потока
+struct PoolStats
+{
+    size_t allocations = 0;             // Запросов на выделение
+    size_t reuses = 0;                  // Из них обслужено из кэша
+    size_t system_allocations = 0;      // Обращений к operator new
+    size_t system_deallocations = 0;    // Обращений к operator delete
+    size_t cached_blocks = 0;           // Блоков в кэше сейчас
+    size_t cached_bytes = 0;            // Байт в кэше сейчас
+};
+
+inline constexpr size_t MIN_BLOCK_BYTES = 64;     // Должно совпадать с 2^6 в ClassIndex
+inline constexpr size_t CLASS_COUNT = 15;
+inline constexpr size_t MAX_BLOCK_BYTES = MIN_BLOCK_BYTES << (CLASS_COUNT - 1);
+inline constexpr size_t DEFAULT_CACHE_LIMIT = 8 * 1024 * 1024;
+
+// Номер размерного класса для блока из bytes байт (bytes <= MAX_BLOCK_BYTES)
+inline size_t ClassIndex(size_t bytes) noexcept
+{
+    if (bytes <= MIN_BLOCK_BYTES)
+    {
+        return 0;
+    }
+    // Степень двойки, не меньшая bytes, минус log2(MIN_BLOCK_BYTES) = 6
+    return sizeof(unsigned long long) * 8 - static_cast<size_t>(__builtin_clzll(bytes - 1)) - 6;
+}
+
+inline size_t ClassBytes(size_t index) noexcept
+{
+    return MIN_BLOCK_BYTES << index;
+}
+
+// Размер блока, выделяемого под bytes байт: блоки, которые может принять кэш, всегда
+// округляются до размера класса, иначе из кэша выдали бы блок меньше запрошенного
+inline size_t BlockBytes(size_t bytes) noexcept
+{
+    return bytes > MAX_BLOCK_BYTES ? bytes : ClassBytes(ClassIndex(bytes));
+}
+
+class ThreadCache
+{
+public:
+    ThreadCache() noexcept = default;
+
+    ThreadCache(const ThreadCache&) = delete;
+    ThreadCache& operator=(const ThreadCache&) = delete;
+
+    ~ThreadCache()
+    {
+        Trim(0);
+        Destroyed() = true;
+    }
+
+    // Кэш текущего потока или nullptr, если он уже разрушен (поток завершается, а память
+    // освобождают объекты со статическим временем жизни)
+    static ThreadCache* Get() noexcept
+    {
+        if (Destroyed())
+        {
+            return nullptr;
+        }
+        thread_local ThreadCache cache;
+        return &cache;
+    }
+
+    void* Allocate(size_t bytes)
+    {
+        ++stats_.allocations;
+        if (bytes > MAX_BLOCK_BYTES)
+        {
+            ++stats_.system_allocations;
+            return ::operator new(bytes);
+        }
+        const size_t index = ClassIndex(bytes);
+        if (FreeBlock* block = heads_[index])
+        {
+            heads_[index] = block->next;
+            ++stats_.reuses;
+            --stats_.cached_blocks;
+            stats_.cached_bytes -= ClassBytes(index);
+            return block;
+        }
+        ++stats_.system_allocations;
+        return ::operator new(ClassBytes(index));
+    }
+
+    void Deallocate(void* ptr, size_t bytes) noexcept
+    {
+        if (bytes > MAX_BLOCK_BYTES)
+        {
+            ++stats_.system_deallocations;
+            ::operator delete(ptr);
+            return;
+        }
+        const size_t index = ClassIndex(bytes);
+        if (stats_.cached_bytes + ClassBytes(index) > limit_)
+        {
+            ++stats_.system_deallocations;
+            ::operator delete(ptr);
+            return;
+        }
+        heads_[index] = ::new (ptr) FreeBlock{ heads_[index] };
+        ++stats_.cached_blocks;
+        stats_.cached_bytes += ClassBytes(index);
+    }
+
+    // Возвращает системе блоки, начиная с крупных, пока в кэше больше keep_bytes байт
+    void Trim(size_t keep_bytes) noexcept
+    {
+        for (size_t index = CLASS_COUNT; index-- > 0 && stats_.cached_bytes > keep_bytes;)
+        {
+            while (heads_[index] != nullptr && stats_.cached_bytes > keep_bytes)
+            {
+                FreeBlock* block = heads_[index];
+                heads_[index] = block->next;
+                ::operator delete(block);
+                ++stats_.system_deallocations;
+                --stats_.cached_blocks;
+                stats_.cached_bytes -= ClassBytes(index);
+            }
+        }
+    }
+
+    void SetLimit(size_t limit) noexcept
+    {
+        limit_ = limit;
+        Trim(limit_);
+    }
+
+    size_t GetLimit() const noexcept
+    {
+        return limit_;
+    }
+
+    const PoolStats& GetStats() const noexcept
+    {
+        return stats_;
+    }
+
+private:
+    // Свободный блок хранит указатель на следующий прямо в своей памяти
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    std::array<FreeBlock*, CLASS_COUNT> heads_{};
+    size_t limit_ = DEFAULT_CACHE_LIMIT;
+    PoolStats stats_;
+
+    // Признак разрушения кэша потока. Тривиальный тип, поэтому доступен до конца жизни потока
+    static bool& Destroyed() noexcept
+    {
+        thread_local bool destroyed = false;
+        return destroyed;
+    }
+};
+
+// Ограничивает объем кэша текущего потока limit байтами, освобождая лишнее
+inline void SetThreadCacheLimit(size_t limit) noexcept
+{
+    if (ThreadCache* cache = ThreadCache::Get())
+    {
+        cache->SetLimit(limit);
+    }
+}
+
+// Возвращает системе блоки кэша текущего потока, оставляя не больше keep_bytes байт
+inline void TrimThreadCache(size_t keep_bytes = 0) noexcept
+{
+    if (ThreadCache* cache = ThreadCache::Get())
+    {
+        cache->Trim(keep_bytes);
+    }
+}
+
+inline PoolStats GetThreadStats() noexcept
+{
+    const ThreadCache* cache = ThreadCache::Get();
+    return cache != nullptr ? cache->GetStats() : PoolStats{};
+}
+
+} // namespace buffer_pool
+
+// Распределитель, берущий буферы из кэша потока (см. buffer_pool). Включается явно:
+//     SimpleVector<int, PoolAllocator<int>> items;
+// Буфер выделяется с округлением до размерного класса, и после разрушения вектора или переезда
+// при росте возвращается в кэш для следующего Reserve/роста вектора близкой емкости
+template <typename Type>
+class PoolAllocator
+{
+    static_assert(alignof(Type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "operator new does not support over-aligned types");
+
+public:
+    using value_type = Type;
+    using is_always_equal = std::true_type;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename Other>
+    PoolAllocator(const PoolAllocator<Other>&) noexcept
+    {
+    }
+
+    Type* allocate(size_t size)
+    {
+        const size_t bytes = BytesFor(size);
+        if (buffer_pool::ThreadCache* cache = buffer_pool::ThreadCache::Get())
+        {
+            return static_cast<Type*>(cache->Allocate(bytes));
+        }
+        // Кэш потока уже разрушен, но блок могут освободить в потоке с живым кэшем
+        return static_cast<Type*>(::operator new(buffer_pool::BlockBytes(bytes)));
+    }
+
+    void deallocate(Type* ptr, size_t size) noexcept
+    {
+        if (buffer_pool::ThreadCache* cache = buffer_pool::ThreadCache::Get())
+        {
+            cache->Deallocate(ptr, size * sizeof(Type));
+            return;
+        }
+        ::operator delete(ptr);
+    }
+
+private:
+    static size_t BytesFor(size_t size)
+    {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type))
+        {
+            throw std::bad_array_new_length();
+        }
+        return size * sizeof(Type);
+    }
+};
+
+template <typename Lhs, typename Rhs>
+inline bool operator==(const PoolAllocator<Lhs>&, const PoolAllocator<Rhs>&) noexcept
+{
+    return true;
+}
+
+template <typename Lhs, typename Rhs>
+inline bool operator!=(const PoolAllocator<Lhs>&, const PoolAllocator<Rhs>&) noexcept
+{
+    return false;
+}
@@ -0,0 +1,598 @@
+#pragma once
+#include "simple_vector.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Размер блока SegmentedSimpleVector по умолчанию: степень двойки, при которой блок занимает
+// около 4 КБ (страницу), но не меньше 16 элементов
+constexpr size_t DefaultSegmentSize(size_t element_size) noexcept
+{
+    size_t size = 16;
+    while (size * 2 * element_size <= 4096)
+    {
+        size *= 2;
+    }
+    return size;
+}
+
+// Вектор с интерфейсом SimpleVector, хранящий элементы в блоках фиксированного размера BlockSize
+// (степень двойки). Таблица блоков - SimpleVector указателей, индекс переводится в (блок, смещение)
+// сдвигом и маской. При росте выделяется новый блок, а перемещаются только указатели в таблице,
+// поэтому PushBack/EmplaceBack/PopBack/Reserve/Resize не перемещают существующие элементы:
+// ссылки и указатели на них остаются действительными до удаления самих элементов.
+// Итераторы (как у std::deque) становятся недействительными при изменении размера
+template <typename Type, size_t BlockSize = DefaultSegmentSize(sizeof(Type)), typename Allocator = std::allocator<Type>>
+class SegmentedSimpleVector
+{
+    static_assert(BlockSize > 0 && (BlockSize & (BlockSize - 1)) == 0, "BlockSize must be a power of two");
+
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using BlockTable = SimpleVector<Type*, typename AllocTraits::template rebind_alloc<Type*>>;
+
+    static constexpr size_t BLOCK_SHIFT = __builtin_ctzll(BlockSize);
+    static constexpr size_t BLOCK_MASK = BlockSize - 1;
+
+    // Итератор произвольного доступа по блокам. Value - Type или const Type
+    template <typename Value>
+    class BasicIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Type* const* blocks, size_t index) noexcept : blocks_(blocks), index_(index)
+        {
+        }
+
+        // Преобразование Iterator в ConstIterator
+        template <typename Other, typename = std::enable_if_t<std::is_const_v<Value> && !std::is_const_v<Other>>>
+        BasicIterator(const BasicIterator<Other>& other) noexcept : blocks_(other.blocks_), index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return blocks_[index_ >> BLOCK_SHIFT][index_ & BLOCK_MASK];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &**this;
+        }
+
+        reference operator[](difference_type offset) const noexcept
+        {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept
+        {
+            BasicIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept
+        {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept
+        {
+            BasicIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept
+        {
+            index_ += static_cast<size_t>(offset);
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept
+        {
+            index_ -= static_cast<size_t>(offset);
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept
+        {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept
+        {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept
+        {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+        size_t GetIndex() const noexcept
+        {
+            return index_;
+        }
+
+    private:
+        template <typename>
+        friend class BasicIterator;
+
+        Type* const* blocks_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+    using AllocatorType = Allocator;
+
+    static constexpr size_t block_size = BlockSize;
+
+    SegmentedSimpleVector() noexcept(noexcept(Allocator()))
+    {
+    }
+
+    explicit SegmentedSimpleVector(const Allocator& alloc) noexcept : blocks_(alloc), alloc_(alloc)
+    {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SegmentedSimpleVector(size_t size, const Allocator& alloc = Allocator()) : SegmentedSimpleVector(alloc)
+    {
+        Resize(size);
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SegmentedSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : SegmentedSimpleVector(alloc)
+    {
+        Reserve(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            EmplaceBack(value);
+        }
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SegmentedSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : SegmentedSimpleVector(alloc)
+    {
+        Reserve(init.size());
+        for (const Type& item : init)
+        {
+            EmplaceBack(item);
+        }
+    }
+
+    SegmentedSimpleVector(ReserveProxyObj obj, const Allocator& alloc = Allocator()) : SegmentedSimpleVector(alloc)
+    {
+        Reserve(obj.reserve_value);
+    }
+
+    SegmentedSimpleVector(const SegmentedSimpleVector& other)
+        : SegmentedSimpleVector(other, AllocTraits::select_on_container_copy_construction(other.alloc_))
+    {
+    }
+
+    // Копирует элементы other в блоки, выделенные распределителем alloc
+    SegmentedSimpleVector(const SegmentedSimpleVector& other, const Allocator& alloc) : SegmentedSimpleVector(alloc)
+    {
+        Reserve(other.size_);
+        for (const Type& item : other)
+        {
+            EmplaceBack(item);
+        }
+    }
+
+    // Распределитель rhs передается, только если propagate_on_container_copy_assignment,
+    // иначе копия строится в блоках распределителя *this
+    SegmentedSimpleVector& operator=(const SegmentedSimpleVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+            {
+                if (alloc_ != rhs.alloc_)
+                {
+                    // Блоки нужно вернуть прежнему распределителю до его замены
+                    DeallocateBlocks();
+                    alloc_ = rhs.alloc_;
+                    const BlockTable empty_table(alloc_);
+                    blocks_ = empty_table;
+                }
+            }
+            SegmentedSimpleVector tmp(rhs, alloc_);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    // Перемещение передает таблицу блоков, сами элементы остаются на месте
+    SegmentedSimpleVector(SegmentedSimpleVector&& other) noexcept
+        : blocks_(std::move(other.blocks_)), size_(std::exchange(other.size_, 0)), alloc_(other.alloc_)
+    {
+    }
+
+    // Таблица блоков передается, если передается распределитель (propagate_on_container_move_assignment)
+    // или распределители равны; иначе элементы перемещаются по одному в блоки *this
+    SegmentedSimpleVector& operator=(SegmentedSimpleVector&& rhs) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+    {
+        if (this != &rhs)
+        {
+            if constexpr (!AllocTraits::propagate_on_container_move_assignment::value
+                          && !AllocTraits::is_always_equal::value)
+            {
+                if (alloc_ != rhs.alloc_)
+                {
+                    Clear();
+                    Reserve(rhs.size_);
+                    for (Type& item : rhs)
+                    {
+                        EmplaceBack(std::move(item));
+                    }
+                    rhs.Clear();
+                    return *this;
+                }
+            }
+
+            DeallocateBlocks();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+            {
+                alloc_ = rhs.alloc_;
+            }
+            blocks_ = std::move(rhs.blocks_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    ~SegmentedSimpleVector()
+    {
+        DeallocateBlocks();
+    }
+
+    Allocator GetAllocator() const noexcept
+    {
+        return alloc_;
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept
+    {
+        return size_;
+    }
+
+    // Возвращает вместимость: число элементов в уже выделенных блоках
+    size_t GetCapacity() const noexcept
+    {
+        return blocks_.GetSize() * BlockSize;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        return blocks_[index >> BLOCK_SHIFT][index & BLOCK_MASK];
+    }
+
+    const Type& operator[](size_t index) const noexcept
+    {
+        assert(index < size_);
+        return blocks_[index >> BLOCK_SHIFT][index & BLOCK_MASK];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index)
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator At())");
+        }
+        return (*this)[index];
+    }
+
+    const Type& At(size_t index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator const At())");
+        }
+        return (*this)[index];
+    }
+
+    // Разрушает все элементы, выделенные блоки остаются для повторного использования
+    void Clear() noexcept
+    {
+        Destroy(0, size_);
+        size_ = 0;
+    }
+
+    // Изменяет размер массива. Новые элементы получают значение по умолчанию,
+    // лишние элементы разрушаются
+    void Resize(size_t new_size)
+    {
+        if (new_size <= size_)
+        {
+            Destroy(new_size, size_);
+            size_ = new_size;
+            return;
+        }
+        Reserve(new_size);
+        while (size_ < new_size)
+        {
+            EmplaceBack();
+        }
+    }
+
+    // Конструирует элемент из args в конце вектора. Существующие элементы не перемещаются
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args)
+    {
+        if (size_ == GetCapacity())
+        {
+            // args могут ссылаться на элемент самого вектора: он остается на месте при добавлении блока
+            AddBlock();
+        }
+        Type* item = &blocks_[size_ >> BLOCK_SHIFT][size_ & BLOCK_MASK];
+        AllocTraits::construct(alloc_, item, std::forward<Args>(args)...);
+        ++size_;
+        return *item;
+    }
+
+    void PushBack(const Type& item)
+    {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item)
+    {
+        EmplaceBack(std::move(item));
+    }
+
+    // Вставляет значение в позицию pos, сдвигая последующие элементы на одну позицию вправо.
+    // Возвращает итератор на вставленное значение
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args)
+    {
+        const size_t offset = pos.GetIndex();
+        assert(offset <= size_);
+        EmplaceBack(std::forward<Args>(args)...);
+        std::rotate(begin() + static_cast<std::ptrdiff_t>(offset), end() - 1, end());
+        return begin() + static_cast<std::ptrdiff_t>(offset);
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value)
+    {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value)
+    {
+        return Emplace(pos, std::move(value));
+    }
+
+    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept
+    {
+        assert(size_ > 0);
+        Destroy(size_ - 1, size_);
+        --size_;
+    }
+
+    // Удаляет элемент вектора в указанной позиции, сдвигая последующие элементы влево
+    Iterator Erase(ConstIterator pos)
+    {
+        const size_t offset = pos.GetIndex();
+        assert(offset < size_);
+        std::move(begin() + static_cast<std::ptrdiff_t>(offset + 1), end(), begin() + static_cast<std::ptrdiff_t>(offset));
+        PopBack();
+        return begin() + static_cast<std::ptrdiff_t>(offset);
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SegmentedSimpleVector& other) noexcept
+    {
+        if constexpr (AllocTraits::propagate_on_container_swap::value)
+        {
+            std::swap(alloc_, other.alloc_);
+        }
+        else
+        {
+            assert(alloc_ == other.alloc_);
+        }
+        blocks_.swap(other.blocks_);
+        std::swap(size_, other.size_);
+    }
+
+    // Выделяет блоки для не менее new_capacity элементов
+    void Reserve(size_t new_capacity)
+    {
+        const size_t block_count = (new_capacity + BLOCK_MASK) >> BLOCK_SHIFT;
+        if (block_count > blocks_.GetSize())
+        {
+            blocks_.Reserve(block_count);
+            while (blocks_.GetSize() < block_count)
+            {
+                AddBlock();
+            }
+        }
+    }
+
+    Iterator begin() noexcept
+    {
+        return Iterator(blocks_.begin(), 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(blocks_.begin(), size_);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return cbegin();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return cend();
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return ConstIterator(blocks_.cbegin(), 0);
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return ConstIterator(blocks_.cbegin(), size_);
+    }
+
+private:
+    BlockTable blocks_;       // Указатели на блоки по BlockSize элементов
+    size_t size_ = 0;         // Количество элементов
+    Allocator alloc_;
+
+    // Разрушает элементы и возвращает все блоки распределителю
+    void DeallocateBlocks() noexcept
+    {
+        Clear();
+        for (Type* block : blocks_)
+        {
+            AllocTraits::deallocate(alloc_, block, BlockSize);
+        }
+        blocks_.Clear();
+    }
+
+    void AddBlock()
+    {
+        Type* block = AllocTraits::allocate(alloc_, BlockSize);
+        try
+        {
+            blocks_.PushBack(block);
+        }
+        catch (...)
+        {
+            AllocTraits::deallocate(alloc_, block, BlockSize);
+            throw;
+        }
+    }
+
+    // Разрушает элементы с индексами [first, last)
+    void Destroy(size_t first, size_t last) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<Type>)
+        {
+            for (size_t index = first; index < last; ++index)
+            {
+                AllocTraits::destroy(alloc_, &(*this)[index]);
+            }
+        }
+    }
+};
+
+template <typename Type, size_t BlockSize, typename Allocator>
+inline bool operator==(const SegmentedSimpleVector<Type, BlockSize, Allocator>& lhs,
+                       const SegmentedSimpleVector<Type, BlockSize, Allocator>& rhs)
+{
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, size_t BlockSize, typename Allocator>
+inline bool operator!=(const SegmentedSimpleVector<Type, BlockSize, Allocator>& lhs,
+                       const SegmentedSimpleVector<Type, BlockSize, Allocator>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t BlockSize, typename Allocator>
+inline bool operator<(const SegmentedSimpleVector<Type, BlockSize, Allocator>& lhs,
+                      const SegmentedSimpleVector<Type, BlockSize, Allocator>& rhs)
+{
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, size_t BlockSize, typename Allocator>
+inline bool operator<=(const SegmentedSimpleVector<Type, BlockSize, Allocator>& lhs,
+                       const SegmentedSimpleVector<Type, BlockSize, Allocator>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t BlockSize, typename Allocator>
+inline bool operator>(const SegmentedSimpleVector<Type, BlockSize, Allocator>& lhs,
+                      const SegmentedSimpleVector<Type, BlockSize, Allocator>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename Type, size_t BlockSize, typename Allocator>
+inline bool operator>=(const SegmentedSimpleVector<Type, BlockSize, Allocator>& lhs,
+                       const SegmentedSimpleVector<Type, BlockSize, Allocator>& rhs)
+{
+    return !(lhs < rhs);
+}
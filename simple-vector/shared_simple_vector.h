@@ -0,0 +1,427 @@
+#pragma once
+#include "simple_vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <initializer_list>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// Вектор с интерфейсом SimpleVector и копированием при записи (copy-on-write).
+// Копии разделяют один буфер (блок со SimpleVector и атомарным счетчиком ссылок), поэтому
+// копирование - это увеличение счетчика, а не копирование элементов. Первый изменяющий вызов
+// (неконстантные operator[], At, begin/end, PushBack, Insert, Erase, Resize и т.д.) у копии,
+// разделяющей буфер, сначала клонирует его. Для чтения без клонирования используйте константные
+// методы или cbegin()/cend(). Разные копии можно использовать из разных потоков; один объект,
+// как и SimpleVector, нельзя одновременно изменять и читать без внешней синхронизации.
+// Копии разделяют и распределитель памяти блока.
+// Неконстантные operator[], At, begin/end, EmplaceBack, Insert и Erase выдают ссылки и итераторы,
+// через которые можно изменить буфер позже. Поэтому после них буфер помечается неразделяемым:
+// следующая копия сразу клонирует его, и запись через выданную ссылку не меняет снимок.
+// Пометка снимается, когда вектор получает новый буфер или Clear делает прежние ссылки
+// недействительными
+template <typename Type, typename Allocator = std::allocator<Type>>
+class SharedSimpleVector
+{
+    using Vector = SimpleVector<Type, Allocator>;
+
+    struct Block
+    {
+        std::atomic<size_t> refs{ 1 };
+        bool shareable = true;    // false, если владелец выдал изменяющие ссылки на элементы
+        Vector items;
+
+        template <typename... Args>
+        explicit Block(Args&&... args) : items(std::forward<Args>(args)...)
+        {
+        }
+    };
+
+    using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+    using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+
+    SharedSimpleVector() noexcept(noexcept(Allocator()))
+    {
+    }
+
+    explicit SharedSimpleVector(const Allocator& alloc) noexcept : alloc_(alloc)
+    {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SharedSimpleVector(size_t size, const Allocator& alloc = Allocator())
+        : alloc_(alloc), block_(MakeBlock(size, alloc))
+    {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SharedSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : alloc_(alloc), block_(MakeBlock(size, value, alloc))
+    {
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SharedSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : alloc_(alloc), block_(MakeBlock(init, alloc))
+    {
+    }
+
+    // Забирает элементы готового SimpleVector без копирования
+    explicit SharedSimpleVector(Vector&& items) : alloc_(items.GetAllocator()), block_(MakeBlock(std::move(items)))
+    {
+    }
+
+    // Копия разделяет буфер с other или клонирует его, если буфер помечен неразделяемым
+    SharedSimpleVector(const SharedSimpleVector& other) : alloc_(other.alloc_), block_(ShareBlock(other.block_))
+    {
+    }
+
+    SharedSimpleVector& operator=(const SharedSimpleVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            SharedSimpleVector tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    SharedSimpleVector(SharedSimpleVector&& other) noexcept
+        : alloc_(other.alloc_), block_(std::exchange(other.block_, nullptr))
+    {
+    }
+
+    SharedSimpleVector& operator=(SharedSimpleVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            SharedSimpleVector tmp(std::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~SharedSimpleVector()
+    {
+        ReleaseBlock();
+    }
+
+    Allocator GetAllocator() const noexcept
+    {
+        return alloc_;
+    }
+
+    // Количество векторов, разделяющих буфер (0 у вектора без буфера)
+    size_t GetUseCount() const noexcept
+    {
+        return block_ != nullptr ? block_->refs.load(std::memory_order_acquire) : 0;
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept
+    {
+        return block_ != nullptr ? block_->items.GetSize() : 0;
+    }
+
+    // Возвращает вместимость массива
+    size_t GetCapacity() const noexcept
+    {
+        return block_ != nullptr ? block_->items.GetCapacity() : 0;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept
+    {
+        return GetSize() == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index. Клонирует разделяемый буфер
+    Type& operator[](size_t index)
+    {
+        return LeakedMutable()[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept
+    {
+        assert(block_ != nullptr);
+        return block_->items[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size. Клонирует разделяемый буфер
+    Type& At(size_t index)
+    {
+        if (index >= GetSize())
+        {
+            throw std::out_of_range("Index is out of range (operator At())");
+        }
+        return LeakedMutable()[index];
+    }
+
+    const Type& At(size_t index) const
+    {
+        if (index >= GetSize())
+        {
+            throw std::out_of_range("Index is out of range (operator const At())");
+        }
+        return block_->items[index];
+    }
+
+    // Разрушает все элементы. Разделяемый буфер не клонируется, а отпускается
+    void Clear() noexcept
+    {
+        if (IsUnique())
+        {
+            block_->items.Clear();
+            block_->shareable = true;
+            return;
+        }
+        ReleaseBlock();
+    }
+
+    void Resize(size_t new_size)
+    {
+        Mutable().Resize(new_size);
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args)
+    {
+        Type& item = AppendItem(std::forward<Args>(args)...);
+        block_->shareable = false;
+        return item;
+    }
+
+    // В отличие от EmplaceBack, не выдает ссылку и не мешает разделять буфер
+    void PushBack(const Type& item)
+    {
+        AppendItem(item);
+    }
+
+    void PushBack(Type&& item)
+    {
+        AppendItem(std::move(item));
+    }
+
+    // Позиция pos в разделяемом буфере переводится в позицию клона
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args)
+    {
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+        if (!IsUnique() && block_ != nullptr)
+        {
+            Type item(std::forward<Args>(args)...);
+            Vector& items = LeakedMutable();
+            return items.Emplace(items.cbegin() + offset, std::move(item));
+        }
+        Vector& items = LeakedMutable();
+        return items.Emplace(items.cbegin() + offset, std::forward<Args>(args)...);
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value)
+    {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value)
+    {
+        return Emplace(pos, std::move(value));
+    }
+
+    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
+    void PopBack()
+    {
+        Mutable().PopBack();
+    }
+
+    Iterator Erase(ConstIterator pos)
+    {
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+        Vector& items = LeakedMutable();
+        return items.Erase(items.cbegin() + offset);
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SharedSimpleVector& other) noexcept
+    {
+        std::swap(block_, other.block_);
+        std::swap(alloc_, other.alloc_);
+    }
+
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity > GetCapacity())
+        {
+            Mutable().Reserve(new_capacity);
+        }
+    }
+
+    // Неконстантные итераторы позволяют изменять элементы и поэтому клонируют разделяемый буфер
+    Iterator begin()
+    {
+        return block_ != nullptr ? LeakedMutable().begin() : nullptr;
+    }
+
+    Iterator end()
+    {
+        return block_ != nullptr ? LeakedMutable().end() : nullptr;
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return cbegin();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return cend();
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return block_ != nullptr ? block_->items.cbegin() : nullptr;
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return block_ != nullptr ? block_->items.cend() : nullptr;
+    }
+
+    // Сообщает, разделяют ли два вектора один буфер
+    bool SharesBufferWith(const SharedSimpleVector& other) const noexcept
+    {
+        return block_ != nullptr && block_ == other.block_;
+    }
+
+private:
+    Allocator alloc_;             // Объявлен до block_: MakeBlock в списке инициализации использует alloc_
+    Block* block_ = nullptr;      // nullptr у пустого вектора без буфера
+
+    template <typename... Args>
+    Block* MakeBlock(Args&&... args)
+    {
+        BlockAllocator block_alloc(alloc_);
+        Block* block = BlockTraits::allocate(block_alloc, 1);
+        try
+        {
+            BlockTraits::construct(block_alloc, block, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            BlockTraits::deallocate(block_alloc, block, 1);
+            throw;
+        }
+        return block;
+    }
+
+    // Буфер для копии: other.block_ со счетчиком ссылок + 1 или клон неразделяемого буфера
+    Block* ShareBlock(Block* block)
+    {
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+        if (!block->shareable)
+        {
+            return MakeBlock(block->items, alloc_);
+        }
+        block->refs.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    // acquire: изменения, сделанные другими владельцами до отпускания буфера, видны этому потоку
+    bool IsUnique() const noexcept
+    {
+        return block_ != nullptr && block_->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    // Возвращает SimpleVector, которым владеет только этот объект, клонируя разделяемый буфер
+    Vector& Mutable()
+    {
+        if (block_ == nullptr)
+        {
+            block_ = MakeBlock(alloc_);
+        }
+        else if (!IsUnique())
+        {
+            Block* clone = MakeBlock(block_->items, alloc_);
+            ReleaseBlock();
+            block_ = clone;
+        }
+        return block_->items;
+    }
+
+    // Mutable для операций, выдающих изменяющие ссылки или итераторы на элементы
+    Vector& LeakedMutable()
+    {
+        Vector& items = Mutable();
+        block_->shareable = false;
+        return items;
+    }
+
+    template <typename... Args>
+    Type& AppendItem(Args&&... args)
+    {
+        // args могут ссылаться на элемент разделяемого буфера, который после клонирования могут
+        // освободить другие владельцы, поэтому новый элемент создается до клонирования
+        if (!IsUnique() && block_ != nullptr)
+        {
+            Type item(std::forward<Args>(args)...);
+            return Mutable().EmplaceBack(std::move(item));
+        }
+        return Mutable().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    void ReleaseBlock() noexcept
+    {
+        if (block_ != nullptr && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            BlockAllocator block_alloc(alloc_);
+            BlockTraits::destroy(block_alloc, block_);
+            BlockTraits::deallocate(block_alloc, block_, 1);
+        }
+        block_ = nullptr;
+    }
+};
+
+template <typename Type, typename Allocator>
+inline bool operator==(const SharedSimpleVector<Type, Allocator>& lhs, const SharedSimpleVector<Type, Allocator>& rhs)
+{
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, typename Allocator>
+inline bool operator!=(const SharedSimpleVector<Type, Allocator>& lhs, const SharedSimpleVector<Type, Allocator>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator>
+inline bool operator<(const SharedSimpleVector<Type, Allocator>& lhs, const SharedSimpleVector<Type, Allocator>& rhs)
+{
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, typename Allocator>
+inline bool operator<=(const SharedSimpleVector<Type, Allocator>& lhs, const SharedSimpleVector<Type, Allocator>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Allocator>
+inline bool operator>(const SharedSimpleVector<Type, Allocator>& lhs, const SharedSimpleVector<Type, Allocator>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator>
+inline bool operator>=(const SharedSimpleVector<Type, Allocator>& lhs, const SharedSimpleVector<Type, Allocator>& rhs)
+{
+    return !(lhs < rhs);
+}
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// SIMD-ядра для SimpleVector из int32_t и float: сравнение, поиск, подсчет, заполнение, сумма, min/max.
+// Ядра собираются для AVX2 и SSE4.1 через target-прагмы (без глобальных флагов -mavx2), а нужный
+// вариант выбирается во время выполнения по возможностям процессора. Загрузки невыровненные, так что
+// ядра работают с любым буфером; AlignedAllocator лишь избавляет их от загрузок через границу кэш-линии.
+// Макрос SIMPLE_VECTOR_DISABLE_SIMD оставляет только скалярную реализацию
+#if !defined(SIMPLE_VECTOR_DISABLE_SIMD) && (defined(__x86_64__) || defined(__i386__)) \
+    && (defined(__GNUC__) || defined(__clang__))
+#define SIMPLE_VECTOR_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace simd
+{
+
+// Типы элементов, для которых есть векторные ядра
+template <typename Type>
+inline constexpr bool is_supported_v = std::is_same_v<Type, std::int32_t> || std::is_same_v<Type, float>;
+
+#if defined(SIMPLE_VECTOR_SIMD_X86)
+
+namespace detail
+{
+inline std::int32_t WrappingAdd(std::int32_t lhs, std::int32_t rhs) noexcept
+{
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(lhs) + static_cast<std::uint32_t>(rhs));
+}
+
+inline float WrappingAdd(float lhs, float rhs) noexcept
+{
+    return lhs + rhs;
+}
+
+} // namespace detail
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace avx2
+{
+// Операции над регистром из Vec<Type>::lanes элементов Type
+template <typename Type>
+struct Vec;
+
+template <>
+struct Vec<std::int32_t>
+{
+    using Type = std::int32_t;
+    using Reg = __m256i;
+    static constexpr size_t lanes = 8;
+
+    static Reg Load(const Type* ptr) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+    static void Store(Type* ptr, Reg value) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value); }
+    static Reg Set1(Type value) noexcept { return _mm256_set1_epi32(value); }
+    static unsigned EqMask(Reg lhs, Reg rhs) noexcept
+    {
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs))));
+    }
+    static Reg Add(Reg lhs, Reg rhs) noexcept { return _mm256_add_epi32(lhs, rhs); }
+    static Reg Min(Reg lhs, Reg rhs) noexcept { return _mm256_min_epi32(lhs, rhs); }
+    static Reg Max(Reg lhs, Reg rhs) noexcept { return _mm256_max_epi32(lhs, rhs); }
+};
+
+template <>
+struct Vec<float>
+{
+    using Type = float;
+    using Reg = __m256;
+    static constexpr size_t lanes = 8;
+
+    static Reg Load(const Type* ptr) noexcept { return _mm256_loadu_ps(ptr); }
+    static void Store(Type* ptr, Reg value) noexcept { _mm256_storeu_ps(ptr, value); }
+    static Reg Set1(Type value) noexcept { return _mm256_set1_ps(value); }
+    // Упорядоченное сравнение: NaN не равен ничему, как и в скалярном operator==
+    static unsigned EqMask(Reg lhs, Reg rhs) noexcept
+    {
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ)));
+    }
+    static Reg Add(Reg lhs, Reg rhs) noexcept { return _mm256_add_ps(lhs, rhs); }
+    static Reg Min(Reg lhs, Reg rhs) noexcept { return _mm256_min_ps(lhs, rhs); }
+    static Reg Max(Reg lhs, Reg rhs) noexcept { return _mm256_max_ps(lhs, rhs); }
+};
+
+#include "simd_kernels.inl"
+} // namespace avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push(__attribute__((target("sse4.1"))), apply_to = function)
+#else
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+#endif
+
+namespace sse41
+{
+template <typename Type>
+struct Vec;
+
+template <>
+struct Vec<std::int32_t>
+{
+    using Type = std::int32_t;
+    using Reg = __m128i;
+    static constexpr size_t lanes = 4;
+
+    static Reg Load(const Type* ptr) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+    static void Store(Type* ptr, Reg value) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), value); }
+    static Reg Set1(Type value) noexcept { return _mm_set1_epi32(value); }
+    static unsigned EqMask(Reg lhs, Reg rhs) noexcept
+    {
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lhs, rhs))));
+    }
+    static Reg Add(Reg lhs, Reg rhs) noexcept { return _mm_add_epi32(lhs, rhs); }
+    static Reg Min(Reg lhs, Reg rhs) noexcept { return _mm_min_epi32(lhs, rhs); }
+    static Reg Max(Reg lhs, Reg rhs) noexcept { return _mm_max_epi32(lhs, rhs); }
+};
+
+template <>
+struct Vec<float>
+{
+    using Type = float;
+    using Reg = __m128;
+    static constexpr size_t lanes = 4;
+
+    static Reg Load(const Type* ptr) noexcept { return _mm_loadu_ps(ptr); }
+    static void Store(Type* ptr, Reg value) noexcept { _mm_storeu_ps(ptr, value); }
+    static Reg Set1(Type value) noexcept { return _mm_set1_ps(value); }
+    static unsigned EqMask(Reg lhs, Reg rhs) noexcept
+    {
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(lhs, rhs)));
+    }
+    static Reg Add(Reg lhs, Reg rhs) noexcept { return _mm_add_ps(lhs, rhs); }
+    static Reg Min(Reg lhs, Reg rhs) noexcept { return _mm_min_ps(lhs, rhs); }
+    static Reg Max(Reg lhs, Reg rhs) noexcept { return _mm_max_ps(lhs, rhs); }
+};
+
+#include "simd_kernels.inl"
+} // namespace sse41
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif // SIMPLE_VECTOR_SIMD_X86
+
+// Набор инструкций, которым пользуются ядра
+enum class Isa
+{
+    SCALAR,
+    SSE41,
+    AVX2
+};
+
+// Определяет лучший доступный набор инструкций один раз за время работы программы
+inline Isa ActiveIsa() noexcept
+{
+#if defined(SIMPLE_VECTOR_SIMD_X86)
+    static const Isa isa = []
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return Isa::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.1"))
+        {
+            return Isa::SSE41;
+        }
+        return Isa::SCALAR;
+    }();
+    return isa;
+#else
+    return Isa::SCALAR;
+#endif
+}
+
+#if defined(SIMPLE_VECTOR_SIMD_X86)
+#define SIMPLE_VECTOR_SIMD_DISPATCH(Kernel, Type, ...)                           \
+    switch (ActiveIsa())                                                          \
+    {                                                                             \
+    case Isa::AVX2:                                                               \
+        return avx2::Kernel<avx2::Vec<Type>>(__VA_ARGS__);                        \
+    case Isa::SSE41:                                                              \
+        return sse41::Kernel<sse41::Vec<Type>>(__VA_ARGS__);                      \
+    case Isa::SCALAR:                                                             \
+        break;                                                                    \
+    }
+#else
+#define SIMPLE_VECTOR_SIMD_DISPATCH(Kernel, Type, ...)
+#endif
+
+// Индекс первой пары несовпадающих элементов или size
+template <typename Type>
+size_t Mismatch(const Type* lhs, const Type* rhs, size_t size) noexcept
+{
+    static_assert(is_supported_v<Type>);
+    SIMPLE_VECTOR_SIMD_DISPATCH(Mismatch, Type, lhs, rhs, size)
+    return static_cast<size_t>(std::mismatch(lhs, lhs + size, rhs).first - lhs);
+}
+
+// Индекс первого элемента, равного value, или size
+template <typename Type>
+size_t Find(const Type* data, size_t size, Type value) noexcept
+{
+    static_assert(is_supported_v<Type>);
+    SIMPLE_VECTOR_SIMD_DISPATCH(Find, Type, data, size, value)
+    return static_cast<size_t>(std::find(data, data + size, value) - data);
+}
+
+template <typename Type>
+size_t Count(const Type* data, size_t size, Type value) noexcept
+{
+    static_assert(is_supported_v<Type>);
+    SIMPLE_VECTOR_SIMD_DISPATCH(Count, Type, data, size, value)
+    return static_cast<size_t>(std::count(data, data + size, value));
+}
+
+template <typename Type>
+void Fill(Type* data, size_t size, Type value) noexcept
+{
+    static_assert(is_supported_v<Type>);
+    SIMPLE_VECTOR_SIMD_DISPATCH(Fill, Type, data, size, value)
+    std::fill(data, data + size, value);
+}
+
+// Сумма элементов. Целые складываются по модулю 2^32 (без неопределенного поведения при переполнении),
+// float - в порядке, отличном от последовательного, поэтому результат может отличаться в младших битах
+template <typename Type>
+Type Sum(const Type* data, size_t size) noexcept
+{
+    static_assert(is_supported_v<Type>);
+    SIMPLE_VECTOR_SIMD_DISPATCH(Sum, Type, data, size)
+    Type result{};
+    for (size_t i = 0; i < size; ++i)
+    {
+        if constexpr (std::is_integral_v<Type>)
+        {
+            result = static_cast<Type>(static_cast<std::make_unsigned_t<Type>>(result)
+                                       + static_cast<std::make_unsigned_t<Type>>(data[i]));
+        }
+        else
+        {
+            result += data[i];
+        }
+    }
+    return result;
+}
+
+// Минимум и максимум size > 0 элементов. Для float с NaN результат не определен
+template <typename Type>
+std::pair<Type, Type> MinMax(const Type* data, size_t size) noexcept
+{
+    static_assert(is_supported_v<Type>);
+    SIMPLE_VECTOR_SIMD_DISPATCH(MinMax, Type, data, size)
+    const auto [min_it, max_it] = std::minmax_element(data, data + size);
+    return { *min_it, *max_it };
+}
+
+#undef SIMPLE_VECTOR_SIMD_DISPATCH
+
+// Лексикографическое сравнение с семантикой std::lexicographical_compare: неупорядоченные пары
+// (NaN) не решают исход и сравнение продолжается со следующего элемента
+template <typename Type>
+bool LexicographicalLess(const Type* lhs, size_t lhs_size, const Type* rhs, size_t rhs_size) noexcept
+{
+    const size_t common = std::min(lhs_size, rhs_size);
+    size_t i = 0;
+    while (true)
+    {
+        i += Mismatch(lhs + i, rhs + i, common - i);
+        if (i == common)
+        {
+            return lhs_size < rhs_size;
+        }
+        if (lhs[i] < rhs[i])
+        {
+            return true;
+        }
+        if (rhs[i] < lhs[i])
+        {
+            return false;
+        }
+        ++i;
+    }
+}
+
+} // namespace simd
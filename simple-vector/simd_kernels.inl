@@ -0,0 +1,147 @@
+// Обобщенные SIMD-ядра. Файл включается из simd_kernels.h несколько раз - внутри пространств имен
+// конкретных наборов инструкций (AVX2, SSE4.1), где функции компилируются с соответствующим target.
+// Ops задает тип элемента и операции над регистром:
+//     Type, Reg, lanes, Load, Store, Set1, EqMask (битовая маска равных дорожек), Add, Min, Max
+
+// Горизонтальная свертка дорожек регистра
+template <typename Ops, typename Combine>
+typename Ops::Type Reduce(typename Ops::Reg value, Combine combine) noexcept
+{
+    typename Ops::Type lanes[Ops::lanes];
+    Ops::Store(lanes, value);
+    typename Ops::Type result = lanes[0];
+    for (size_t i = 1; i < Ops::lanes; ++i)
+    {
+        result = combine(result, lanes[i]);
+    }
+    return result;
+}
+
+// Индекс первого несовпадающего элемента a и b или n, если все совпадают
+template <typename Ops>
+size_t Mismatch(const typename Ops::Type* a, const typename Ops::Type* b, size_t n) noexcept
+{
+    constexpr unsigned full_mask = (1u << Ops::lanes) - 1;
+    size_t i = 0;
+    for (; i + Ops::lanes <= n; i += Ops::lanes)
+    {
+        const unsigned mask = Ops::EqMask(Ops::Load(a + i), Ops::Load(b + i));
+        if (mask != full_mask)
+        {
+            return i + static_cast<size_t>(__builtin_ctz(~mask & full_mask));
+        }
+    }
+    for (; i < n; ++i)
+    {
+        if (!(a[i] == b[i]))
+        {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Индекс первого элемента, равного value, или n
+template <typename Ops>
+size_t Find(const typename Ops::Type* data, size_t n, typename Ops::Type value) noexcept
+{
+    const typename Ops::Reg needle = Ops::Set1(value);
+    size_t i = 0;
+    for (; i + Ops::lanes <= n; i += Ops::lanes)
+    {
+        const unsigned mask = Ops::EqMask(Ops::Load(data + i), needle);
+        if (mask != 0)
+        {
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+    for (; i < n; ++i)
+    {
+        if (data[i] == value)
+        {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Количество элементов, равных value
+template <typename Ops>
+size_t Count(const typename Ops::Type* data, size_t n, typename Ops::Type value) noexcept
+{
+    const typename Ops::Reg needle = Ops::Set1(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + Ops::lanes <= n; i += Ops::lanes)
+    {
+        count += static_cast<size_t>(__builtin_popcount(Ops::EqMask(Ops::Load(data + i), needle)));
+    }
+    for (; i < n; ++i)
+    {
+        count += (data[i] == value) ? 1 : 0;
+    }
+    return count;
+}
+
+// Записывает value в n элементов начиная с data
+template <typename Ops>
+void Fill(typename Ops::Type* data, size_t n, typename Ops::Type value) noexcept
+{
+    const typename Ops::Reg filler = Ops::Set1(value);
+    size_t i = 0;
+    for (; i + Ops::lanes <= n; i += Ops::lanes)
+    {
+        Ops::Store(data + i, filler);
+    }
+    for (; i < n; ++i)
+    {
+        data[i] = value;
+    }
+}
+
+// Сумма n элементов
+template <typename Ops>
+typename Ops::Type Sum(const typename Ops::Type* data, size_t n) noexcept
+{
+    typename Ops::Reg acc = Ops::Set1(typename Ops::Type{});
+    size_t i = 0;
+    for (; i + Ops::lanes <= n; i += Ops::lanes)
+    {
+        acc = Ops::Add(acc, Ops::Load(data + i));
+    }
+    typename Ops::Type result = Reduce<Ops>(acc, [](auto lhs, auto rhs) { return detail::WrappingAdd(lhs, rhs); });
+    for (; i < n; ++i)
+    {
+        result = detail::WrappingAdd(result, data[i]);
+    }
+    return result;
+}
+
+// Минимум и максимум n > 0 элементов
+template <typename Ops>
+std::pair<typename Ops::Type, typename Ops::Type> MinMax(const typename Ops::Type* data, size_t n) noexcept
+{
+    using Type = typename Ops::Type;
+    Type min_value = data[0];
+    Type max_value = data[0];
+    size_t i = 0;
+    if (n >= Ops::lanes)
+    {
+        typename Ops::Reg min_reg = Ops::Load(data);
+        typename Ops::Reg max_reg = min_reg;
+        for (i = Ops::lanes; i + Ops::lanes <= n; i += Ops::lanes)
+        {
+            const typename Ops::Reg values = Ops::Load(data + i);
+            min_reg = Ops::Min(min_reg, values);
+            max_reg = Ops::Max(max_reg, values);
+        }
+        min_value = Reduce<Ops>(min_reg, [](Type lhs, Type rhs) { return rhs < lhs ? rhs : lhs; });
+        max_value = Reduce<Ops>(max_reg, [](Type lhs, Type rhs) { return lhs < rhs ? rhs : lhs; });
+    }
+    for (; i < n; ++i)
+    {
+        min_value = data[i] < min_value ? data[i] : min_value;
+        max_value = max_value < data[i] ? data[i] : max_value;
+    }
+    return { min_value, max_value };
+}
@@ -1,15 +1,24 @@
 #pragma once
+#include "aligned_allocator.h"
 #include "array_ptr.h"
+#include "growth_policy.h"
+#include "parallel_for.h"
+#include "vector_stats.h"
 
 #include <cassert>
 #include <initializer_list>
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
 #include <array>
+#include <atomic>
+#include <functional>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
-
-using namespace std;
+#include <vector>
 
 // Класс-обертка для различия версий конструкторов с параметрами size и reserve (оба типа size_t)
 class ReserveProxyObj
@@ -24,22 +33,37 @@ public:
 };
 
 // Функция, создающая прокси-объект для передачи его в конструктор SimpleVector
-ReserveProxyObj Reserve(size_t capacity_to_reserve)
+inline ReserveProxyObj Reserve(size_t capacity_to_reserve)
 {
     return ReserveProxyObj(capacity_to_reserve);
 }
 
-template <typename Type>
-class SimpleVector
+// Память выделяется через распределитель Allocator (std::allocator_traits),
+// правила propagate_on_container_* соблюдаются при копировании, перемещении и обмене.
+// GrowthPolicy задает новую емкость при нехватке места и, если умеет, уменьшенную емкость после
+// удаления элементов (см. growth_policy.h). Политики по умолчанию емкость не уменьшают.
+// StatsPolicy получает события выделения памяти, роста и копирования/перемещения элементов
+// (см. vector_stats.h); политика по умолчанию пустая и ничего не стоит
+template <typename Type, typename Allocator = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth,
+          typename StatsPolicy = DefaultVectorStats<Type>>
+class SimpleVector : private StatsPolicy
 {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
 public:
     using Iterator = Type*;
     using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+    using GrowthPolicyType = GrowthPolicy;
 
-    SimpleVector() noexcept = default;
+    SimpleVector() noexcept(noexcept(Allocator())) = default;
+
+    explicit SimpleVector(const Allocator& alloc) noexcept : internal_array_(alloc)
+    {
+    }
 
 
-// Марина М. если std::move(Type()) заменить на Type{}, то получится практически реализация 
+// Марина М. если std::move(Type()) заменить на Type{}, то получится практически реализация
 //           конструктора со значением, можно делегировать работу ему. Все-таки Type{} - это тоже некое значение
 
     /*
@@ -52,82 +76,225 @@ public:
     }
     */
 
-    explicit SimpleVector(size_t size) : SimpleVector(size, Type{})
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SimpleVector(size_t size, const Allocator& alloc = Allocator())
+        : capacity_(size), internal_array_(size, alloc)
     {
+        internal_array_.UninitializedValueConstruct(begin(), begin() + size);
+        size_ = size;
+        RecordAllocation(capacity_);
     }
 
     // Создаёт вектор из size элементов, инициализированных значением value
-    SimpleVector(size_t size, const Type& value) : size_(size), capacity_(size), internal_array_(size)
+    SimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : capacity_(size), internal_array_(size, alloc)
     {
-        std::fill(internal_array_.Get(), internal_array_.Get() + size, value);
+        internal_array_.UninitializedFill(begin(), begin() + size, value);
+        size_ = size;
+        RecordAllocation(capacity_);
+        Stats().OnCopy(size_);
     }
 
-    // Создаёт вектор из size элементов, инициализированных значением rvalue
-    SimpleVector(size_t size, Type&& rvalue) : size_(size), capacity_(size), internal_array_(size)
+    // Создаёт вектор из size элементов, инициализированных значением rvalue.
+    // Для некопируемых типов rvalue перемещается в первый элемент, остальные
+    // получают значение по умолчанию
+    SimpleVector(size_t size, Type&& rvalue, const Allocator& alloc = Allocator())
+        : capacity_(size), internal_array_(size, alloc)
     {
-        CustomFill(internal_array_.Get(), internal_array_.Get() + size);
-        *begin() = std::move(rvalue);
+        if constexpr (std::is_copy_constructible_v<Type>)
+        {
+            internal_array_.UninitializedFill(begin(), begin() + size, rvalue);
+        }
+        else if (size > 0)
+        {
+            internal_array_.Construct(begin(), std::move(rvalue));
+            try
+            {
+                internal_array_.UninitializedValueConstruct(begin() + 1, begin() + size);
+            }
+            catch (...)
+            {
+                internal_array_.Destroy(begin(), begin() + 1);
+                throw;
+            }
+        }
+        size_ = size;
+        RecordAllocation(capacity_);
     }
 
     // Создаёт вектор из std::initializer_list
-    SimpleVector(std::initializer_list<Type> init) : size_(init.size()), capacity_(init.size()), internal_array_(init.size())
+    SimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : capacity_(init.size()), internal_array_(init.size(), alloc)
     {
-        // Перемещаем элементы, т.к. они могут быть без конструктора копирования
-        static_cast<void>(std::move(init.begin(), init.end(), internal_array_.Get()));
+        // Элементы initializer_list константны, поэтому их можно только копировать
+        internal_array_.UninitializedCopy(init.begin(), init.end(), begin());
+        size_ = init.size();
+        RecordAllocation(capacity_);
+        Stats().OnCopy(size_);
     }
 
     SimpleVector(const SimpleVector& other)
+        : SimpleVector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
     {
-        // Допущение: временный вектор создается с capacity==size, а не с capacity==other.capacity
-        SimpleVector tmp_vector(other.size_);
-        std::copy(other.begin(), other.end(), tmp_vector.begin());
-        SimpleVector::swap(tmp_vector);
+    }
+
+    SimpleVector(const SimpleVector& other, const Allocator& alloc)
+        : capacity_(other.size_), internal_array_(other.size_, alloc)
+    {
+        // Допущение: вектор создается с capacity==size, а не с capacity==other.capacity
+        internal_array_.UninitializedCopy(other.begin(), other.end(), begin());
+        size_ = other.size_;
+        RecordAllocation(capacity_);
+        Stats().OnCopy(size_);
     }
 
     SimpleVector& operator=(const SimpleVector& rhs)
     {
         if (this != &rhs)
         {
-            auto tmp_rhs(rhs);
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+            {
+                if (GetAllocator() != rhs.GetAllocator())
+                {
+                    // Память нужно вернуть прежнему распределителю до его замены
+                    DestroyAll();
+                    internal_array_.ResetAllocator(rhs.GetAllocator());
+                    capacity_ = 0;
+                }
+            }
+            SimpleVector tmp_rhs(rhs, GetAllocator());
             SimpleVector::swap(tmp_rhs);
         }
         return *this;
     }
 
     // Конструктор перемещения
-    SimpleVector(SimpleVector&& other) noexcept : size_(other.size_), capacity_(other.capacity_)
+    SimpleVector(SimpleVector&& other) noexcept
+        : size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , internal_array_(std::move(other.internal_array_))
+    {
+    }
+
+    // Конструктор перемещения с заданным распределителем. Если распределители различны,
+    // память other забрать нельзя и элементы перемещаются по одному
+    SimpleVector(SimpleVector&& other, const Allocator& alloc) : internal_array_(alloc)
     {
-        if (this != &other)
+        if (alloc == other.GetAllocator())
         {
             internal_array_.swap(other.internal_array_);
-            std::swap(this->size_, other.size_);
-            std::swap(this->capacity_, other.capacity_);
-            // Очищаем аргумент (делаем перемещение)
-            other.Clear();
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+        else
+        {
+            MoveElementsFrom(other);
         }
-
     }
 
     // Конструктор присваивания перемещением
-    SimpleVector& operator=(SimpleVector&& rhs) noexcept
+    SimpleVector& operator=(SimpleVector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                                        || AllocTraits::is_always_equal::value)
     {
         if (this != &rhs)
         {
-            internal_array_.swap(rhs.internal_array_);
-            std::swap(this->size_, rhs.size_);
-            std::swap(this->capacity_, rhs.capacity_);
-            // Очищаем аргумент (делаем перемещение)
-            rhs.Clear();
+            // Разрушаем свои элементы заранее, т.к. память будет заменена
+            DestroyAll();
+
+            if constexpr (!AllocTraits::propagate_on_container_move_assignment::value
+                          && !AllocTraits::is_always_equal::value)
+            {
+                if (GetAllocator() != rhs.GetAllocator())
+                {
+                    MoveElementsFrom(rhs);
+                    return *this;
+                }
+            }
+
+            RecordDeallocation(capacity_);
+            internal_array_ = std::move(rhs.internal_array_);
+            size_ = std::exchange(rhs.size_, 0);
+            capacity_ = std::exchange(rhs.capacity_, 0);
         }
 
         // Возвращаем *this во всех случаях
         return *this;
     }
 
-    SimpleVector(ReserveProxyObj obj) : size_(0u), capacity_(obj.reserve_value), internal_array_(capacity_)
+    SimpleVector(ReserveProxyObj obj, const Allocator& alloc = Allocator())
+        : size_(0u), capacity_(obj.reserve_value), internal_array_(capacity_, alloc)
+    {
+        // Т.к. этот конструктор создает вектор с заданной емкостью, но с размером 0,
+        // память остается неинициализированной (нет элементов для конструирования)
+        RecordAllocation(capacity_);
+    }
+
+    // Параллельные версии конструкторов для больших векторов: элементы создаются кусками в
+    // нескольких потоках (см. ParallelConstruct), малые векторы - в вызывающем потоке
+    SimpleVector(const parallel::ParallelPolicy& policy, size_t size, const Allocator& alloc = Allocator())
+        : capacity_(size), internal_array_(size, alloc)
+    {
+        ParallelConstruct(policy, size, [this](Type* first, Type* last)
+            {
+                internal_array_.UninitializedValueConstruct(first, last);
+            });
+        size_ = size;
+        RecordAllocation(capacity_);
+    }
+
+    SimpleVector(const parallel::ParallelPolicy& policy, size_t size, const Type& value,
+                 const Allocator& alloc = Allocator())
+        : capacity_(size), internal_array_(size, alloc)
+    {
+        ParallelConstruct(policy, size, [this, &value](Type* first, Type* last)
+            {
+                internal_array_.UninitializedFill(first, last, value);
+            });
+        size_ = size;
+        RecordAllocation(capacity_);
+        Stats().OnCopy(size_);
+    }
+
+    SimpleVector(const parallel::ParallelPolicy& policy, const SimpleVector& other)
+        : SimpleVector(policy, other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {
+    }
+
+    SimpleVector(const parallel::ParallelPolicy& policy, const SimpleVector& other, const Allocator& alloc)
+        : capacity_(other.size_), internal_array_(other.size_, alloc)
     {
-        // Т.к. этот конструктор создает вектор с заданной емкостью, но с размером 0, 
-        // вызывать fill не требуется (нет элементов для заполнения)
+        const Type* source = other.begin();
+        Type* dest = begin();
+        ParallelConstruct(policy, other.size_, [this, source, dest](Type* first, Type* last)
+            {
+                internal_array_.UninitializedCopy(source + (first - dest), source + (last - dest), first);
+            });
+        size_ = other.size_;
+        RecordAllocation(capacity_);
+        Stats().OnCopy(size_);
+    }
+
+    // Разрушает элементы [0, size_). Память освобождает ArrayPtr
+    ~SimpleVector()
+    {
+        internal_array_.Destroy(begin(), end());
+        Stats().OnDestroy(size_, capacity_);
+        RecordDeallocation(capacity_);
+    }
+
+    // Возвращает счетчики политики статистики этого вектора (нули, если статистика выключена).
+    // wasted_capacity - текущая неиспользуемая емкость
+    VectorStatsCounters GetStats() const noexcept
+    {
+        VectorStatsCounters counters = StatsPolicy::GetCounters();
+        counters.wasted_capacity = capacity_ - size_;
+        return counters;
+    }
+
+    // Возвращает копию распределителя памяти
+    Allocator GetAllocator() const noexcept
+    {
+        return internal_array_.GetAllocator();
     }
 
     // Возвращает количество элементов в массиве
@@ -152,10 +319,10 @@ public:
     Type& operator[](size_t index) noexcept
     {
 
-// Марина М. в реализации не хватает проверки, что индекс не превышает размерности вектора 
-        assert(index >= 0 && index < size_);
+// Марина М. в реализации не хватает проверки, что индекс не превышает размерности вектора
+        assert(index < size_);
 
-// Марина М. в ArrayPtr у вас реализованы квадратные скобки, поэтому можно их использовать 
+// Марина М. в ArrayPtr у вас реализованы квадратные скобки, поэтому можно их использовать
         //return *(internal_array_.Get() + index);
         return internal_array_.Get()[index];
     }
@@ -164,10 +331,10 @@ public:
     const Type& operator[](size_t index) const noexcept
     {
 
-// Марина М. в реализации не хватает проверки, что индекс не превышает размерности вектора 
-        assert(index >= 0 && index < size_);
+// Марина М. в реализации не хватает проверки, что индекс не превышает размерности вектора
+        assert(index < size_);
 
-        // Марина М. в ArrayPtr у вас реализованы квадратные скобки, поэтому можно их использовать 
+        // Марина М. в ArrayPtr у вас реализованы квадратные скобки, поэтому можно их использовать
         //return *(internal_array_.Get() + index);
         return internal_array_.Get()[index];
     }
@@ -178,7 +345,7 @@ public:
     {
         if (index >= size_)
         {
-            throw out_of_range("Index is out of range (operator At())"s);
+            throw std::out_of_range("Index is out of range (operator At())");
         }
         return *(internal_array_.Get() + index);
     }
@@ -189,191 +356,214 @@ public:
     {
         if (index >= size_)
         {
-            throw out_of_range("Index is out of range (operator const At())"s);
+            throw std::out_of_range("Index is out of range (operator const At())");
         }
         return *(internal_array_.Get() + index);
     }
 
-    // Обнуляет размер массива, не изменяя его вместимость
+    // Разрушает все элементы и обнуляет размер массива. Вместимость уменьшается, только если
+    // этого требует политика роста
     void Clear() noexcept
     {
-        size_ = 0;
+        DestroyAll();
+        TrimCapacity();
     }
 
-    // Изменяет размер массива (количество элементов со значениями). size <= capacity
-    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    // Присваивает всем элементам значение value
+    void Fill(const Type& value)
+    {
+        std::fill(begin(), end(), value);
+        Stats().OnCopy(size_);
+    }
+
+    // То же, кусками в нескольких потоках. При исключении часть элементов может остаться прежней
+    void Fill(const parallel::ParallelPolicy& policy, const Type& value)
+    {
+        Type* data = begin();
+        parallel::ForEachChunk(size_, parallel::ChunkCount(policy, size_ * sizeof(Type)),
+            [data, &value](size_t, size_t first, size_t last)
+            {
+                std::fill(data + first, data + last, value);
+            });
+        Stats().OnCopy(size_);
+    }
+
+    // Изменяет размер массива (количество элементов со значениями).
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type,
+    // при уменьшении лишние элементы разрушаются
     void Resize(size_t new_size)
     {
-        // Изменяем размер только когда новый размер больше старого
-        if (new_size > size_)
+        if (new_size <= size_)
         {
-            // Новый размер меньше емкости. Просто обнуляем добавляемые сверх size_ элементы
-            if (new_size <= capacity_)
-            {
-                CustomFill(internal_array_.Get() + size_, internal_array_.Get() + new_size);
-            }
-            else
-            {
-                // Новый размер больше вместимости. Реалоцируем память под более емкий массив
-                const size_t new_capacity = std::max(new_size, 2 * capacity_);
-                ArrayPtr<Type> buffer(new_capacity);
-
-                // Обнуляем новые значащие элементы [size...new_size)
-                CustomFill(buffer.Get() + size_, buffer.Get() + new_size);
-                // Перемещаем старые элементы (move т.к. могут быть элементы без конструктора копирования)
-                std::move(internal_array_.Get(), internal_array_.Get() + size_, buffer.Get());
-                // Меняем указатели на массивы 
-                internal_array_.swap(buffer);
-                capacity_ = new_capacity;
-            }
+            internal_array_.Destroy(begin() + new_size, end());
+            size_ = new_size;
+            TrimCapacity();
+            return;
+        }
+
+        // Новый размер больше вместимости. Реалоцируем память под более емкий массив
+        if (new_size > capacity_)
+        {
+            Reallocate(NextCapacity(new_size));
         }
 
+        // Конструируем новые значащие элементы [size...new_size)
+        internal_array_.UninitializedValueConstruct(end(), begin() + new_size);
+
         // Запоминаем новый размер вектора.
         size_ = new_size;
     }
 
-    // Добавляет элемент в конец вектора
+    // Конструирует элемент из args в конце вектора и возвращает ссылку на него
     // При нехватке места увеличивает вдвое вместимость вектора
-    void PushBack(const Type& item)
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args)
     {
-
+        RecordInsertedValue<Args...>();
         if (size_ < capacity_)
         {
-            std::exchange(internal_array_[size_], item);
+            internal_array_.Construct(end(), std::forward<Args>(args)...);
             ++size_;
         }
         else
         {
-            // Выделяем новый массив с удвоенной емкостью
-            const size_t new_capacity = (capacity_ > 0 ? 2 * capacity_ : 1);
-            ArrayPtr<Type> buffer(new_capacity);
-
-            // Копируем исходный вектор во временный буфер
-            std::copy(internal_array_.Get(), internal_array_.Get() + size_, buffer.Get());
-            // Копируем добавляемое значение в конец буфера
-            std::exchange(buffer[size_], item);
-            // Меняем указатели на массивы 
-            buffer.swap(internal_array_);
-            capacity_ = new_capacity;
-            ++size_;
+            // args могут ссылаться на элемент самого вектора, поэтому
+            // новый элемент создается до перемещения старых элементов
+            ReallocateAndConstruct(size_, std::forward<Args>(args)...);
         }
+        return *(end() - 1);
+    }
 
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вдвое вместимость вектора
+    void PushBack(const Type& item)
+    {
+        EmplaceBack(item);
     }
 
     // Добавляет элемент (rvalue) в конец вектора перемещением
     // При нехватке места увеличивает вдвое вместимость вектора
     void PushBack(Type&& item)
     {
-
-        if (size_ < capacity_)
-        {
-            std::exchange(internal_array_[size_], std::move(item));
-            ++size_;
-        }
-        else
-        {
-            // Выделяем новый массив с удвоенной емкостью
-            const size_t new_capacity = (capacity_ > 0 ? 2 * capacity_ : 1);
-            ArrayPtr<Type> buffer(new_capacity);
-
-            // Перемещаем исходный вектор во временный буфер
-            std::move(internal_array_.Get(), internal_array_.Get() + size_, buffer.Get());
-            // Перемещаем добавляемое значение в конец буфера
-            std::exchange(buffer[size_], std::move(item));
-            // Меняем указатели на массивы 
-            buffer.swap(internal_array_);
-            capacity_ = new_capacity;
-            ++size_;
-        }
+        EmplaceBack(std::move(item));
     }
 
-    // Вставляет значение value в позицию pos.
+    // Конструирует элемент из args в позиции pos.
     // Возвращает итератор на вставленное значение
     // Если перед вставкой значения вектор был заполнен полностью,
     // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью 0 стать равной 1
-    Iterator Insert(ConstIterator pos, const Type& value)
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args)
     {
 
-// Марина М. в метода Insert и Erase не хватает проверки (assert), что указанная позиция 
+// Марина М. в метода Insert и Erase не хватает проверки (assert), что указанная позиция
 // попадает в интервал от начала до конца вектора
         assert(pos >= begin() && pos <= end());
 
-        auto offset_start = std::distance(cbegin(), pos);
+        const size_t offset_start = static_cast<size_t>(std::distance(cbegin(), pos));
+        RecordInsertedValue<Args...>();
 
-        if (size_ < capacity_)
+        if (size_ == capacity_)
+        {
+            ReallocateAndConstruct(offset_start, std::forward<Args>(args)...);
+        }
+        else if (offset_start == size_)
         {
-            // Сдвигаем элементы по одному к концу вектора начиная с конца, освобождая pos
-            std::copy_backward(pos, cend(), end() + 1);
-            // Вставляем value
-            internal_array_[offset_start] = value;
+            internal_array_.Construct(end(), std::forward<Args>(args)...);
             ++size_;
         }
         else
         {
-            // Выделяем новый массив с удвоенной емкостью
-            const size_t new_capacity = (size_ > 0 ? 2 * capacity_ : 1);
-            ArrayPtr<Type> buffer(new_capacity);
-
-            // Копируем начало вектора до точки вставки
-            std::copy(begin(), Iterator(pos), buffer.Get());
-            // Вставляем добавляемое значение в позицию pos
-            buffer[offset_start] = value;
-            // Копируем оставшуюся часть вектора
-            // buffer.Get() + отступ до места вставки + 1 вставленное значение
-            std::copy(pos, cend(), buffer.Get() + offset_start + 1);
-            // Меняем указатели на массивы 
-            internal_array_.swap(buffer);
-            capacity_ = new_capacity;
-            ++size_;
+            // args могут ссылаться на сдвигаемый элемент вектора, поэтому сначала создаем значение
+            Type tmp_value(std::forward<Args>(args)...);
+            InsertWithShift(offset_start, std::move(tmp_value));
         }
 
         return Iterator{ &internal_array_[offset_start] };
     }
 
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value)
+    {
+        return Emplace(pos, value);
+    }
+
     // Вставляет значение value (rvalue) в позицию pos перемещением.
     // Возвращает итератор на вставленное значение
-    // Если перед вставкой значения вектор был заполнен полностью,
-    // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью 0 стать равной 1
     Iterator Insert(ConstIterator pos, Type&& value)
     {
+        return Emplace(pos, std::move(value));
+    }
 
-// Марина М. в метода Insert и Erase не хватает проверки (assert), что указанная позиция 
-// попадает в интервал от начала до конца вектора
+    // Вставляет count копий value в позицию pos. Память перераспределяется не более одного раза.
+    // Возвращает итератор на первый вставленный элемент
+    Iterator Insert(ConstIterator pos, size_t count, const Type& value)
+    {
         assert(pos >= begin() && pos <= end());
 
-        auto offset_start = std::distance(cbegin(), pos);
+        // value может ссылаться на элемент вектора, который будет сдвинут или перемещен
+        const Type tmp_value(value);
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+        Stats().OnCopy(count);
+        InsertRange(offset, count, [&](Type* dest, size_t first_index, size_t last_index)
+            {
+                internal_array_.UninitializedFill(dest, dest + (last_index - first_index), tmp_value);
+            },
+            [&](Type* dest, size_t first_index, size_t last_index)
+            {
+                std::fill(dest, dest + (last_index - first_index), tmp_value);
+            });
+        return begin() + offset;
+    }
 
-        if (size_ < capacity_)
+    // Вставляет элементы диапазона [first, last) в позицию pos. Итоговый размер вычисляется заранее,
+    // поэтому память перераспределяется не более одного раза.
+    // Диапазон не должен указывать на элементы самого вектора.
+    // Возвращает итератор на первый вставленный элемент
+    template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+    Iterator Insert(ConstIterator pos, InputIt first, InputIt last)
+    {
+        assert(pos >= begin() && pos <= end());
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
         {
-            // Сдвигаем элементы по одному к концу вектора начиная с конца, освобождая pos
-            std::move_backward(Iterator(pos), Iterator(cend()), Iterator(end() + 1));
-            // Используем семантику перемещения для некопируемых value
-            std::exchange(internal_array_[offset_start], std::move(value));
-            ++size_;
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            Stats().OnCopy(count);
+            InsertRange(offset, count, [&](Type* dest, size_t first_index, size_t last_index)
+                {
+                    auto it = std::next(first, static_cast<std::ptrdiff_t>(first_index));
+                    internal_array_.UninitializedCopy(it, std::next(it, static_cast<std::ptrdiff_t>(last_index - first_index)), dest);
+                },
+                [&](Type* dest, size_t first_index, size_t last_index)
+                {
+                    auto it = std::next(first, static_cast<std::ptrdiff_t>(first_index));
+                    std::copy(it, std::next(it, static_cast<std::ptrdiff_t>(last_index - first_index)), dest);
+                });
         }
         else
         {
-            // Выделяем новый массив с удвоенной емкостью
-            const size_t new_capacity = (size_ > 0 ? 2 * capacity_ : 1);
-            ArrayPtr<Type> buffer(new_capacity);
-
-            // Перемещаем начало вектора до точки вставки во временный буфер
-            std::move(begin(), Iterator(pos), buffer.Get());
-            // Перемещаем добавляемое значение в позицию pos
-            std::exchange(buffer[offset_start], std::move(value));
-            // Перемещаем оставшуюся часть вектора
-            // buffer.Get() + отступ до места вставки + 1 вставленное значение
-            std::move(Iterator(pos), Iterator(cend()), Iterator(buffer.Get() + offset_start + 1));
-            // Меняем указатели на массивы 
-            internal_array_.swap(buffer);
-            capacity_ = new_capacity;
-            ++size_;
+            // Однопроходный диапазон нельзя измерить заранее: собираем его во временный вектор
+            SimpleVector tmp(GetAllocator());
+            for (; first != last; ++first)
+            {
+                tmp.EmplaceBack(*first);
+            }
+            Insert(begin() + offset, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
         }
+        return begin() + offset;
+    }
 
-        return Iterator{ &internal_array_[offset_start] };
+    // Добавляет элементы диапазона [first, last) в конец вектора
+    template <typename InputIt>
+    void Append(InputIt first, InputIt last)
+    {
+        Insert(cend(), first, last);
     }
 
-    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
     void PopBack() noexcept
     {
 
@@ -384,24 +574,179 @@ public:
         }*/
         assert(!IsEmpty());
         --size_;
+        internal_array_.Destroy(end(), end() + 1);
+        TrimCapacity();
     }
 
     // Удаляет элемент вектора в указанной позиции
     Iterator Erase(ConstIterator pos)
     {
 
-// Марина М. в метода Insert и Erase не хватает проверки (assert), что указанная позиция 
+// Марина М. в метода Insert и Erase не хватает проверки (assert), что указанная позиция
 // попадает в интервал от начала до конца вектора
-        assert(pos >= begin() && pos <= end());
+        assert(pos >= begin() && pos < end());
+
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост один раз. Возвращает итератор на элемент,
+    // следовавший за удаленными
+    Iterator Erase(ConstIterator first, ConstIterator last)
+    {
+        assert(first >= begin() && first <= last && last <= end());
+
+        const size_t offset = static_cast<size_t>(first - cbegin());
+        const size_t count = static_cast<size_t>(last - first);
+        if (count == 0)
+        {
+            return begin() + offset;
+        }
+        Iterator it = begin() + offset;
+        const size_t tail = size_ - offset - count;
+        Stats().OnMove(tail);
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            // Разрушаем удаляемые элементы и сдвигаем хвост одним memmove
+            internal_array_.Destroy(it, it + count);
+            ArrayPtr<Type, Allocator>::RawShift(it + count, tail, it);
+        }
+        else
+        {
+            // Сдвигаем хвост к началу вектора, затирая удаляемые элементы
+            // Используем move итераторы
+            std::move(it + count, end(), it);
+            // Последние count элементов теперь "пустые" (перемещены), разрушаем их
+            internal_array_.Destroy(end() - count, end());
+        }
+        size_ -= count;
+        // Уменьшение емкости переносит элементы, поэтому итератор вычисляется заново
+        TrimCapacity();
+        return begin() + offset;
+    }
+
+    // Удаляет все элементы, для которых pred(item) == true, за один проход с сохранением порядка
+    // остальных. Возвращает количество удаленных элементов.
+    // Если pred выбросит исключение, непроверенные элементы остаются в векторе (у тривиально
+    // перемещаемых типов порядок и состав оставшихся элементов корректны, у остальных часть
+    // элементов может оказаться в перемещенном состоянии)
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred)
+    {
+        Type* const first = begin();
+        Type* const last = end();
+        Type* write = first;
+        size_t moved = 0;
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            // Удаляемые элементы разрушаются на месте, а серии оставшихся между ними сдвигаются
+            // к началу одним memmove на серию
+            Type* run = first;
+            Type* read = first;
+            const auto shift_run = [&](Type* run_end)
+            {
+                const size_t run_size = static_cast<size_t>(run_end - run);
+                if (write != run)
+                {
+                    ArrayPtr<Type, Allocator>::RawShift(run, run_size, write);
+                    moved += run_size;
+                }
+                write += run_size;
+            };
+            try
+            {
+                for (; read != last; ++read)
+                {
+                    if (pred(*read))
+                    {
+                        shift_run(read);
+                        internal_array_.Destroy(read, read + 1);
+                        run = read + 1;
+                    }
+                }
+            }
+            catch (...)
+            {
+                // Закрываем пропуски: сдвигаем текущую серию вместе с непроверенными элементами
+                shift_run(last);
+                size_ = static_cast<size_t>(write - first);
+                Stats().OnMove(moved);
+                throw;
+            }
+            shift_run(last);
+        }
+        else
+        {
+            for (Type* read = first; read != last; ++read)
+            {
+                if (!pred(*read))
+                {
+                    if (write != read)
+                    {
+                        *write = std::move(*read);
+                        ++moved;
+                    }
+                    ++write;
+                }
+            }
+            internal_array_.Destroy(write, last);
+        }
+        Stats().OnMove(moved);
+        const size_t removed = static_cast<size_t>(last - write);
+        size_ -= removed;
+        TrimCapacity();
+        return removed;
+    }
+
+    // Удаляет все элементы, равные value. Возвращает количество удаленных элементов
+    size_t Remove(const Type& value)
+    {
+        // value может ссылаться на элемент самого вектора, который будет разрушен или перемещен
+        if (!std::less<const Type*>()(&value, cbegin()) && std::less<const Type*>()(&value, cend()))
+        {
+            const Type copy(value);
+            return Remove(copy);
+        }
+        return EraseIf([&value](const Type& item)
+            {
+                return item == value;
+            });
+    }
+
+    // Удаляет элемент в позиции pos за O(1), перенося на его место последний элемент.
+    // Порядок элементов не сохраняется. Возвращает итератор на элемент, занявший позицию pos
+    // (end(), если удален последний элемент)
+    Iterator UnorderedErase(ConstIterator pos)
+    {
+        assert(pos >= begin() && pos < end());
 
-        // Сдвигаем элементы после pos по одному к началу вектора, затирая pos
-        // Используем move итераторы
-        std::move(Iterator(pos + 1), Iterator(cend()), Iterator(pos));
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+        Iterator it = begin() + offset;
+        Iterator back = end() - 1;
+        if (it != back)
+        {
+            Stats().OnMove(1);
+            if constexpr (is_trivially_relocatable_v<Type>)
+            {
+                internal_array_.Destroy(it, it + 1);
+                ArrayPtr<Type, Allocator>::RawShift(back, 1, it);
+            }
+            else
+            {
+                *it = std::move(*back);
+                internal_array_.Destroy(back, back + 1);
+            }
+        }
+        else
+        {
+            internal_array_.Destroy(back, back + 1);
+        }
         --size_;
-        return Iterator(pos);
+        TrimCapacity();
+        return begin() + offset;
     }
 
-    // Обменивает значение с другим вектором
+    // Обменивает значение с другим вектором.
+    // Распределители обмениваются, только если propagate_on_container_swap, иначе они обязаны быть равны
     void swap(SimpleVector& other) noexcept
     {
         // Проверка самоприсваивания (через адрес)
@@ -420,16 +765,24 @@ public:
     {
         if (new_capacity > capacity_)
         {
-            ArrayPtr<Type> buffer(new_capacity);
-            std::move(internal_array_.Get(), internal_array_.Get() + size_, buffer.Get());
-            // Оптимизация: не используем fill для области резервной памяти (size_...capacity_)
-            internal_array_.swap(buffer);
-            capacity_ = new_capacity;
+            // Область резервной памяти (size_...capacity_) остается неинициализированной
+            Reallocate(new_capacity);
             // size_ не изменяем, т.к. количество элементов не меняется
         }
     }
 
 
+    // Уменьшает емкость до размера, освобождая неиспользуемую память (у пустого вектора - всю).
+    // Элементы переезжают в новый буфер (тривиально перемещаемые - через realloc/memcpy).
+    // Если не удастся выделить память, вектор не изменится
+    void ShrinkToFit()
+    {
+        if (capacity_ > size_)
+        {
+            Reallocate(size_);
+        }
+    }
+
     // Возвращает итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
     Iterator begin() noexcept
@@ -476,58 +829,504 @@ private:
     size_t size_ = 0;         // Количество элементов в векторе
     size_t capacity_ = 0;     // Выделено памяти в векторе (элементов)
 
-    // Внутренний массив, управляемый умным указателем
-    ArrayPtr<Type> internal_array_;
+    // Внутренний массив, управляемый умным указателем.
+    // Сконструированы только элементы [0, size_), остальная память "сырая"
+    ArrayPtr<Type, Allocator> internal_array_;
+
+    StatsPolicy& Stats() noexcept
+    {
+        return *this;
+    }
+
+    void RecordAllocation(size_t capacity) noexcept
+    {
+        if (capacity > 0)
+        {
+            Stats().OnAllocate(capacity);
+        }
+    }
+
+    void RecordDeallocation(size_t capacity) noexcept
+    {
+        if (capacity > 0)
+        {
+            Stats().OnDeallocate(capacity);
+        }
+    }
+
+    // Переезд в новый буфер емкостью new_capacity: выделение, перемещение элементов, освобождение старого
+    void RecordReallocation(size_t new_capacity) noexcept
+    {
+        if (new_capacity < capacity_)
+        {
+            Stats().OnShrink(capacity_, new_capacity);
+        }
+        else
+        {
+            Stats().OnGrowth(capacity_, new_capacity);
+        }
+        RecordAllocation(new_capacity);
+        Stats().OnMove(size_);
+        RecordDeallocation(capacity_);
+    }
+
+    // Учитывает новый элемент, созданный из args: копия из const Type&, перемещение из Type&&
+    template <typename... Args>
+    void RecordInsertedValue() noexcept
+    {
+        if constexpr (sizeof...(Args) == 1)
+        {
+            using Arg = std::tuple_element_t<0, std::tuple<Args...>>;
+            if constexpr (std::is_same_v<std::decay_t<Arg>, Type>)
+            {
+                if constexpr (std::is_rvalue_reference_v<Arg&&> && !std::is_const_v<std::remove_reference_t<Arg>>)
+                {
+                    Stats().OnMove(1);
+                }
+                else
+                {
+                    Stats().OnCopy(1);
+                }
+            }
+        }
+    }
+
+    // Создает элементы [begin(), begin() + size) кусками в нескольких потоках: construct(first, last)
+    // конструирует один кусок. Память выделена, но еще не тронута, поэтому каждый поток первым
+    // касается страниц своего куска, и на NUMA-системах они размещаются в памяти его узла.
+    // При исключении уже созданные куски разрушаются, исключение пробрасывается
+    template <typename Construct>
+    void ParallelConstruct(const parallel::ParallelPolicy& policy, size_t size, Construct construct)
+    {
+        const size_t chunk_count = parallel::ChunkCount(policy, size * sizeof(Type));
+        Type* data = begin();
+        std::vector<char> constructed(chunk_count, false);
+        try
+        {
+            parallel::ForEachChunk(size, chunk_count, [&](size_t chunk, size_t first, size_t last)
+                {
+                    construct(data + first, data + last);
+                    constructed[chunk] = true;
+                });
+        }
+        catch (...)
+        {
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+            {
+                if (constructed[chunk])
+                {
+                    internal_array_.Destroy(data + parallel::ChunkBegin(size, chunk_count, chunk),
+                                            data + parallel::ChunkBegin(size, chunk_count, chunk + 1));
+                }
+            }
+            throw;
+        }
+    }
+
+    // Разрушает все элементы, не изменяя емкость
+    void DestroyAll() noexcept
+    {
+        internal_array_.Destroy(begin(), end());
+        size_ = 0;
+    }
+
+    // После удаления элементов уменьшает емкость, если этого требует политика роста.
+    // Уменьшение необязательно, поэтому нехватка памяти оставляет прежний буфер. Типы, перемещение
+    // которых может выбросить исключение, не переносятся, чтобы не оставить элементы в перемещенном состоянии
+    void TrimCapacity() noexcept
+    {
+        if constexpr (has_shrink_capacity_v<GrowthPolicy>
+                      && (is_trivially_relocatable_v<Type> || std::is_nothrow_move_constructible_v<Type>))
+        {
+            const size_t new_capacity = std::max(GrowthPolicy::ShrinkCapacity(capacity_, size_, sizeof(Type)), size_);
+            if (new_capacity < capacity_)
+            {
+                try
+                {
+                    Reallocate(new_capacity);
+                }
+                catch (...)
+                {
+                }
+            }
+        }
+    }
+
+    // Возвращает емкость для роста вектора до размера не менее required по политике роста
+    size_t NextCapacity(size_t required) const noexcept
+    {
+        return GrowthPolicy::NextCapacity(capacity_, required, sizeof(Type));
+    }
+
+    // Перемещает элементы в новый буфер емкостью new_capacity >= size_.
+    // Тривиально перемещаемые типы переносятся одной операцией с памятью (memcpy/realloc)
+    void Reallocate(size_t new_capacity)
+    {
+        RecordReallocation(new_capacity);
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            internal_array_.Reallocate(new_capacity, size_);
+        }
+        else
+        {
+            ArrayPtr<Type, Allocator> buffer(new_capacity, internal_array_.GetAllocator());
+            buffer.UninitializedMove(begin(), end(), buffer.Get());
+            internal_array_.Destroy(begin(), end());
+            internal_array_.swap(buffer);
+        }
+        capacity_ = new_capacity;
+    }
+
+    // Выделяет буфер увеличенной емкости, конструирует в нем новый элемент в позиции offset
+    // из args и перемещает вокруг него старые элементы
+    template <typename... Args>
+    void ReallocateAndConstruct(size_t offset, Args&&... args)
+    {
+        const size_t new_capacity = NextCapacity(size_ + 1);
+
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            // args могут ссылаться на элементы вектора, а старый блок после realloc недоступен,
+            // поэтому новый элемент сначала создается во временном объекте
+            Type tmp_item(std::forward<Args>(args)...);
+            Reallocate(new_capacity);
+            Stats().OnMove(size_ - offset);
+            ArrayPtr<Type, Allocator>::RawShift(begin() + offset, size_ - offset, begin() + offset + 1);
+            internal_array_.Construct(begin() + offset, std::move(tmp_item));
+            ++size_;
+            return;
+        }
+
+        RecordReallocation(new_capacity);
+        ArrayPtr<Type, Allocator> buffer(new_capacity, internal_array_.GetAllocator());
+        Type* new_item = buffer.Get() + offset;
+
+        // Новый элемент конструируется первым: args могут ссылаться на элементы вектора
+        buffer.Construct(new_item, std::forward<Args>(args)...);
+        try
+        {
+            buffer.UninitializedMove(begin(), begin() + offset, buffer.Get());
+            try
+            {
+                buffer.UninitializedMove(begin() + offset, end(), new_item + 1);
+            }
+            catch (...)
+            {
+                buffer.Destroy(buffer.Get(), new_item);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            buffer.Destroy(new_item, new_item + 1);
+            throw;
+        }
+
+        internal_array_.Destroy(begin(), end());
+        internal_array_.swap(buffer);
+        capacity_ = new_capacity;
+        ++size_;
+    }
 
-// Марина М. стиль наименования функции не совпадает с единым стилем в реализации
-// ----Станислав М. ОК. Стиль подражал стилю std::fill, std:copy_backward и т.д.
-    // Заполнение диапазона некопируемыми типами
-    void CustomFill(Iterator first, Iterator last)
+    // Вставляет value в позицию offset при size_ < capacity_, сдвигая хвост на одну позицию
+    void InsertWithShift(size_t offset, Type&& value)
     {
-        assert(first < last);
-        while (first < last)
+        Stats().OnMove(size_ - offset + 1);
+        if (offset == size_)
         {
-            *first = std::move(Type());
-            ++first;
+            internal_array_.Construct(end(), std::move(value));
         }
+        else if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            // Хвост сдвигается одним memmove, на освободившемся месте конструируется value
+            ArrayPtr<Type, Allocator>::RawShift(begin() + offset, size_ - offset, begin() + offset + 1);
+            internal_array_.Construct(begin() + offset, std::move(value));
+        }
+        else
+        {
+            // Последний элемент переезжает в неинициализированную память за концом,
+            // остальные сдвигаются присваиванием перемещением
+            internal_array_.Construct(end(), std::move(*(end() - 1)));
+            std::move_backward(begin() + offset, end() - 1, end());
+            internal_array_[offset] = std::move(value);
+        }
+        ++size_;
+    }
+
+    // Вставляет count элементов в позицию offset не более чем с одним перераспределением памяти.
+    // construct(dest, i, j) конструирует элементы [i, j) вставляемой последовательности
+    // в неинициализированной памяти dest, assign(dest, i, j) присваивает их уже существующим
+    template <typename ConstructFn, typename AssignFn>
+    void InsertRange(size_t offset, size_t count, ConstructFn construct, AssignFn assign)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (size_ + count > capacity_)
+        {
+            const size_t new_capacity = NextCapacity(size_ + count);
+            RecordReallocation(new_capacity);
+            ArrayPtr<Type, Allocator> buffer(new_capacity, internal_array_.GetAllocator());
+            Type* gap = buffer.Get() + offset;
+
+            construct(gap, 0, count);
+            try
+            {
+                buffer.UninitializedMove(begin(), begin() + offset, buffer.Get());
+                try
+                {
+                    buffer.UninitializedMove(begin() + offset, end(), gap + count);
+                }
+                catch (...)
+                {
+                    buffer.Destroy(buffer.Get(), gap);
+                    throw;
+                }
+            }
+            catch (...)
+            {
+                buffer.Destroy(gap, gap + count);
+                throw;
+            }
+
+            internal_array_.Destroy(begin(), end());
+            internal_array_.swap(buffer);
+            capacity_ = new_capacity;
+            size_ += count;
+            return;
+        }
+
+        Type* gap = begin() + offset;
+        const size_t elems_after = size_ - offset;
+        Stats().OnMove(elems_after);
+
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            // Хвост сдвигается одним memmove, в освободившееся место конструируются новые элементы
+            ArrayPtr<Type, Allocator>::RawShift(gap, elems_after, gap + count);
+            try
+            {
+                construct(gap, 0, count);
+            }
+            catch (...)
+            {
+                ArrayPtr<Type, Allocator>::RawShift(gap + count, elems_after, gap);
+                throw;
+            }
+        }
+        else if (elems_after > count)
+        {
+            // Последние count элементов переезжают в неинициализированную память за концом,
+            // остальная часть хвоста сдвигается присваиванием, новые значения присваиваются
+            Type* old_end = end();
+            internal_array_.UninitializedMove(old_end - count, old_end, old_end);
+            size_ += count;
+            std::move_backward(gap, old_end - count, old_end);
+            assign(gap, 0, count);
+            return;
+        }
+        else
+        {
+            // Часть новых элементов конструируется за концом, хвост переезжает за них,
+            // оставшиеся новые значения присваиваются на место хвоста
+            Type* old_end = end();
+            construct(old_end, elems_after, count);
+            try
+            {
+                internal_array_.UninitializedMove(gap, old_end, gap + count);
+            }
+            catch (...)
+            {
+                internal_array_.Destroy(old_end, old_end + (count - elems_after));
+                throw;
+            }
+            size_ += count;
+            assign(gap, 0, elems_after);
+            return;
+        }
+        size_ += count;
+    }
+
+    // Поэлементно перемещает содержимое other в пустой *this (распределители различны)
+    void MoveElementsFrom(SimpleVector& other)
+    {
+        assert(size_ == 0);
+        Reserve(other.size_);
+        internal_array_.UninitializedMove(other.begin(), other.end(), begin());
+        Stats().OnMove(other.size_);
+        size_ = other.size_;
+        other.DestroyAll();
     }
 };
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline bool operator==(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& rhs)
 {
-    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+    if constexpr (simd::is_supported_v<Type>)
+    {
+        return lhs.GetSize() == rhs.GetSize() && simd::Mismatch(lhs.cbegin(), rhs.cbegin(), lhs.GetSize()) == lhs.GetSize();
+    }
+    else
+    {
+        return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+    }
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
+// Параллельное сравнение больших векторов: куски сравниваются в нескольких потоках, и все потоки
+// прекращают работу, как только один из них нашел различие
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+bool Equal(const parallel::ParallelPolicy& policy, const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& lhs,
+           const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& rhs)
+{
+    if (lhs.GetSize() != rhs.GetSize())
+    {
+        return false;
+    }
+    // Шаг проверки флага: достаточно крупный, чтобы не мешать SIMD-сравнению
+    constexpr size_t block = 64 * 1024;
+    std::atomic<bool> equal{ true };
+    parallel::ForEachChunk(lhs.GetSize(), parallel::ChunkCount(policy, lhs.GetSize() * sizeof(Type)),
+        [&](size_t, size_t first, size_t last)
+        {
+            for (; first < last && equal.load(std::memory_order_relaxed); first += std::min(block, last - first))
+            {
+                const size_t count = std::min(block, last - first);
+                bool block_equal = false;
+                if constexpr (simd::is_supported_v<Type>)
+                {
+                    block_equal = simd::Mismatch(lhs.cbegin() + first, rhs.cbegin() + first, count) == count;
+                }
+                else
+                {
+                    block_equal = std::equal(lhs.cbegin() + first, lhs.cbegin() + first + count, rhs.cbegin() + first);
+                }
+                if (!block_equal)
+                {
+                    equal.store(false, std::memory_order_relaxed);
+                }
+            }
+        });
+    return equal.load();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline bool operator!=(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& rhs)
 {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline bool operator<(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& rhs)
 {
-    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+    if constexpr (simd::is_supported_v<Type>)
+    {
+        return simd::LexicographicalLess(lhs.cbegin(), lhs.GetSize(), rhs.cbegin(), rhs.GetSize());
+    }
+    else
+    {
+        return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+    }
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline bool operator<=(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& rhs)
 {
     // выражение SimpleVector1 <= SimpleVector2 противоположно SimpleVector2 < SimpleVector1
     return !(rhs < lhs);
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline bool operator>(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& rhs)
 {
     // выражение SimpleVector1 > SimpleVector2 эквивалентно SimpleVector2 < SimpleVector1
     return rhs < lhs;
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline bool operator>=(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& rhs)
 {
     // выражение SimpleVector1 >= SimpleVector2 противоположно SimpleVector2 > SimpleVector1
     return !(rhs > lhs);
 }
+
+// Поиск, подсчет и свертки по элементам вектора. Для int32_t и float используются SIMD-ядра
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+auto Find(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items, const Type& value)
+{
+    if constexpr (simd::is_supported_v<Type>)
+    {
+        return items.cbegin() + simd::Find(items.cbegin(), items.GetSize(), value);
+    }
+    else
+    {
+        return std::find(items.cbegin(), items.cend(), value);
+    }
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+size_t Count(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items, const Type& value)
+{
+    if constexpr (simd::is_supported_v<Type>)
+    {
+        return simd::Count(items.cbegin(), items.GetSize(), value);
+    }
+    else
+    {
+        return static_cast<size_t>(std::count(items.cbegin(), items.cend(), value));
+    }
+}
+
+// Сумма элементов (см. simd::Sum о переполнении целых и порядке сложения float)
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+Type Sum(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items)
+{
+    if constexpr (simd::is_supported_v<Type>)
+    {
+        return simd::Sum(items.cbegin(), items.GetSize());
+    }
+    else
+    {
+        Type result{};
+        for (const Type& item : items)
+        {
+            result += item;
+        }
+        return result;
+    }
+}
+
+// Минимальный и максимальный элементы непустого вектора
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+std::pair<Type, Type> MinMax(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items)
+{
+    assert(!items.IsEmpty());
+    if constexpr (simd::is_supported_v<Type>)
+    {
+        return simd::MinMax(items.cbegin(), items.GetSize());
+    }
+    else
+    {
+        const auto [min_it, max_it] = std::minmax_element(items.cbegin(), items.cend());
+        return { *min_it, *max_it };
+    }
+}
+
+// SimpleVector с буфером, выровненным по Alignment байт (по умолчанию - по кэш-линии)
+template <typename Type, size_t Alignment = 64>
+using AlignedSimpleVector = SimpleVector<Type, AlignedAllocator<Type, Alignment>>;
+
+// SimpleVector, память которого берется из std::pmr::memory_resource
+// (например, std::pmr::monotonic_buffer_resource)
+namespace pmr
+{
+template <typename Type>
+using SimpleVector = ::SimpleVector<Type, std::pmr::polymorphic_allocator<Type>>;
+}
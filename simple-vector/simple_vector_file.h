@@ -0,0 +1,396 @@
+#pragma once
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Двоичный формат файла SimpleVector тривиально копируемых элементов (POSIX):
+//     заголовок SimpleVectorFileHeader, нули до data_offset, count элементов как есть в памяти.
+// data_offset кратен выравниванию типа, а отображение файла начинается с границы страницы,
+// поэтому OpenMapped отдает элементы прямо из отображенных страниц без копирования.
+// Ошибки ввода-вывода сообщаются исключением std::system_error, ошибки формата - std::runtime_error
+
+// Заголовок файла. Поля записываются в порядке байт записавшей машины; byte_order позволяет
+// распознать файл с другим порядком байт
+struct SimpleVectorFileHeader
+{
+    static constexpr char MAGIC[8] = { 'S', 'M', 'P', 'L', 'V', 'E', 'C', '\0' };
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static constexpr size_t SIZE = 64;          // Место, отведенное под заголовок в файле
+
+    char magic[8] = {};
+    uint32_t version = 0;
+    uint32_t byte_order = 0;
+    uint32_t type_size = 0;
+    uint32_t type_alignment = 0;
+    uint64_t data_offset = 0;
+    uint64_t count = 0;
+    uint64_t checksum = 0;                      // SimpleVectorChecksum данных
+
+    template <typename Type>
+    static SimpleVectorFileHeader For(size_t count, uint64_t checksum) noexcept
+    {
+        SimpleVectorFileHeader header;
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.byte_order = BYTE_ORDER_MARK;
+        header.type_size = sizeof(Type);
+        header.type_alignment = alignof(Type);
+        header.data_offset = (SIZE + alignof(Type) - 1) / alignof(Type) * alignof(Type);
+        header.count = count;
+        header.checksum = checksum;
+        return header;
+    }
+
+    // Проверяет сигнатуру, версию и порядок байт, иначе выбрасывает std::runtime_error
+    void ValidateFormat() const
+    {
+        if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            throw std::runtime_error("Not a SimpleVector file");
+        }
+        if (version != VERSION)
+        {
+            throw std::runtime_error("Unsupported SimpleVector file version " + std::to_string(version));
+        }
+        if (byte_order != BYTE_ORDER_MARK)
+        {
+            throw std::runtime_error("SimpleVector file has a different byte order");
+        }
+    }
+
+    // Проверяет, что файл содержит элементы типа Type, иначе выбрасывает std::runtime_error
+    template <typename Type>
+    void Validate() const
+    {
+        ValidateFormat();
+        if (type_size != sizeof(Type) || type_alignment != alignof(Type))
+        {
+            throw std::runtime_error("SimpleVector file element type mismatch: size " + std::to_string(type_size)
+                                     + ", alignment " + std::to_string(type_alignment));
+        }
+        if (data_offset < SIZE || data_offset % alignof(Type) != 0)
+        {
+            throw std::runtime_error("Invalid SimpleVector file data offset");
+        }
+    }
+};
+
+static_assert(sizeof(SimpleVectorFileHeader) <= SimpleVectorFileHeader::SIZE);
+static_assert(std::is_trivially_copyable_v<SimpleVectorFileHeader>);
+
+// Контрольная сумма данных: FNV-1a по 64-битным словам (хвост - по байтам).
+// Сумму можно продолжить, передав предыдущий результат в seed, если предыдущие части кратны 8 байтам
+inline uint64_t SimpleVectorChecksum(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ULL) noexcept
+{
+    constexpr uint64_t prime = 0x100000001b3ULL;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+    }
+    for (; i < size; ++i)
+    {
+        hash = (hash ^ bytes[i]) * prime;
+    }
+    return hash;
+}
+
+namespace simple_vector_file
+{
+
+[[noreturn]] inline void ThrowSystemError(const std::string& what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Владеет файловым дескриптором
+class FileDescriptor
+{
+public:
+    FileDescriptor(const std::string& path, int flags, mode_t mode = 0644) : fd_(::open(path.c_str(), flags, mode))
+    {
+        if (fd_ < 0)
+        {
+            ThrowSystemError("Cannot open " + path);
+        }
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    ~FileDescriptor()
+    {
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+    }
+
+    int Get() const noexcept
+    {
+        return fd_;
+    }
+
+    // Закрывает дескриптор, сообщая об ошибке (например, отложенной ошибке записи)
+    void Close()
+    {
+        const int fd = std::exchange(fd_, -1);
+        if (::close(fd) != 0)
+        {
+            ThrowSystemError("Cannot close file");
+        }
+    }
+
+private:
+    int fd_;
+};
+
+// Записывает size байт, повторяя write после частичной записи и прерывания сигналом
+inline void WriteAll(int fd, const void* data, size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            ThrowSystemError("Cannot write SimpleVector data");
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+} // namespace simple_vector_file
+
+// Сохраняет элементы items в файл path. Файл сначала пишется рядом под временным именем и
+// затем атомарно переименовывается, так что читатели не увидят наполовину записанный файл
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void Save(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items, const std::string& path)
+{
+    static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable elements can be saved as is");
+    using namespace simple_vector_file;
+
+    const size_t bytes = items.GetSize() * sizeof(Type);
+    const SimpleVectorFileHeader header =
+        SimpleVectorFileHeader::For<Type>(items.GetSize(), SimpleVectorChecksum(items.cbegin(), bytes));
+    char prefix[SimpleVectorFileHeader::SIZE + alignof(Type)] = {};
+    std::memcpy(prefix, &header, sizeof(header));
+
+    const std::string tmp_path = path + ".tmp";
+    try
+    {
+        FileDescriptor file(tmp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC);
+        WriteAll(file.Get(), prefix, header.data_offset);
+        WriteAll(file.Get(), items.cbegin(), bytes);
+        file.Close();
+        if (::rename(tmp_path.c_str(), path.c_str()) != 0)
+        {
+            ThrowSystemError("Cannot rename " + tmp_path + " to " + path);
+        }
+    }
+    catch (...)
+    {
+        ::unlink(tmp_path.c_str());
+        throw;
+    }
+}
+
+// Насколько тщательно OpenMapped проверяет файл
+enum class MappedVerify
+{
+    HEADER,       // Только заголовок и размер файла: страницы данных читаются по требованию
+    CHECKSUM      // Дополнительно контрольная сумма: читает весь файл при открытии
+};
+
+// Отображение файла SimpleVector в память только для чтения. Элементы не копируются:
+// begin()/end()/operator[] указывают прямо в отображенные страницы, которые ядро подгружает
+// при первом обращении и может вытеснять без записи в подкачку
+template <typename Type>
+class MmapView
+{
+    static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable elements can be mapped");
+
+public:
+    using ConstIterator = const Type*;
+
+    MmapView() noexcept = default;
+
+    MmapView(const MmapView&) = delete;
+    MmapView& operator=(const MmapView&) = delete;
+
+    MmapView(MmapView&& other) noexcept
+        : mapping_(std::exchange(other.mapping_, nullptr))
+        , mapping_size_(std::exchange(other.mapping_size_, 0))
+        , header_(std::exchange(other.header_, SimpleVectorFileHeader{}))
+    {
+    }
+
+    MmapView& operator=(MmapView&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Unmap();
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            mapping_size_ = std::exchange(other.mapping_size_, 0);
+            header_ = std::exchange(other.header_, SimpleVectorFileHeader{});
+        }
+        return *this;
+    }
+
+    ~MmapView()
+    {
+        Unmap();
+    }
+
+    // Отображает файл path, сохраненный функцией Save для элементов того же типа
+    static MmapView Open(const std::string& path, MappedVerify verify = MappedVerify::HEADER)
+    {
+        using namespace simple_vector_file;
+
+        FileDescriptor file(path, O_RDONLY | O_CLOEXEC);
+        struct stat file_stat{};
+        if (::fstat(file.Get(), &file_stat) != 0)
+        {
+            ThrowSystemError("Cannot stat " + path);
+        }
+        const size_t file_size = static_cast<size_t>(file_stat.st_size);
+        if (file_size < sizeof(SimpleVectorFileHeader))
+        {
+            throw std::runtime_error("SimpleVector file is truncated: " + path);
+        }
+
+        MmapView view;
+        view.mapping_ = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, file.Get(), 0);
+        if (view.mapping_ == MAP_FAILED)
+        {
+            view.mapping_ = nullptr;
+            ThrowSystemError("Cannot map " + path);
+        }
+        view.mapping_size_ = file_size;
+
+        std::memcpy(&view.header_, view.mapping_, sizeof(view.header_));
+        view.header_.template Validate<Type>();
+        if (view.header_.data_offset > file_size
+            || view.header_.count > (file_size - view.header_.data_offset) / sizeof(Type))
+        {
+            throw std::runtime_error("SimpleVector file is truncated: " + path);
+        }
+        if (verify == MappedVerify::CHECKSUM)
+        {
+            view.Verify();
+        }
+        return view;
+    }
+
+    // Проверяет контрольную сумму данных, выбрасывая std::runtime_error при несовпадении
+    void Verify() const
+    {
+        if (SimpleVectorChecksum(cbegin(), GetSize() * sizeof(Type)) != header_.checksum)
+        {
+            throw std::runtime_error("SimpleVector file checksum mismatch");
+        }
+    }
+
+    size_t GetSize() const noexcept
+    {
+        return static_cast<size_t>(header_.count);
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return GetSize() == 0;
+    }
+
+    const Type& operator[](size_t index) const noexcept
+    {
+        assert(index < GetSize());
+        return cbegin()[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const
+    {
+        if (index >= GetSize())
+        {
+            throw std::out_of_range("Index is out of range (operator const At())");
+        }
+        return cbegin()[index];
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return cbegin();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return cend();
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        if (mapping_ == nullptr)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const Type*>(static_cast<const char*>(mapping_) + header_.data_offset);
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return cbegin() + GetSize();
+    }
+
+    // Копирует элементы в изменяемый SimpleVector
+    template <typename Allocator = std::allocator<Type>>
+    SimpleVector<Type, Allocator> ToSimpleVector(const Allocator& alloc = Allocator()) const
+    {
+        SimpleVector<Type, Allocator> items(alloc);
+        items.Insert(items.cend(), cbegin(), cend());
+        return items;
+    }
+
+private:
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    SimpleVectorFileHeader header_;
+
+    void Unmap() noexcept
+    {
+        if (mapping_ != nullptr)
+        {
+            ::munmap(mapping_, mapping_size_);
+            mapping_ = nullptr;
+        }
+    }
+};
+
+// Отображает файл SimpleVector в память, см. MmapView
+template <typename Type>
+MmapView<Type> OpenMapped(const std::string& path, MappedVerify verify = MappedVerify::HEADER)
+{
+    return MmapView<Type>::Open(path, verify);
+}
@@ -0,0 +1,537 @@
+#pragma once
+#include "simple_vector_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Потоковая передача SimpleVector через std::ostream/std::istream или файловый дескриптор
+// (канал, сокет, файл) без промежуточного буфера на весь вектор.
+// Поток начинается с заголовка SimpleVectorFileHeader (нули до data_offset), за которым идут элементы:
+//   - тривиально копируемые - как есть в памяти, поэтому поток совпадает с файлом, записанным Save,
+//     и проверяется контрольной суммой. Запись идет одним writev прямо из хранилища вектора,
+//     чтение - крупными частями прямо в хранилище;
+//   - остальные - через кодек ElementCodec<Type>; в заголовке type_size == 0, контрольной суммы нет.
+// ReadFrom резервирует память под count элементов из заголовка, так что вектор не перевыделяется.
+// Ошибки ввода-вывода дескриптора сообщаются std::system_error, ошибки потока и формата - std::runtime_error
+
+// Кодек элемента нетривиального типа. Специализация должна предоставлять
+//     template <typename Writer> static void Encode(Writer& out, const Type& item);
+//     template <typename Reader> static Type Decode(Reader& in);
+// где out.Write(data, size) и in.Read(data, size) передают байты
+template <typename Type, typename = void>
+struct ElementCodec;
+
+// Строка: длина (uint64_t), затем символы
+template <typename Char, typename Traits, typename Allocator>
+struct ElementCodec<std::basic_string<Char, Traits, Allocator>>
+{
+    using String = std::basic_string<Char, Traits, Allocator>;
+
+    template <typename Writer>
+    static void Encode(Writer& out, const String& item)
+    {
+        const uint64_t size = item.size();
+        out.Write(&size, sizeof(size));
+        out.Write(item.data(), item.size() * sizeof(Char));
+    }
+
+    template <typename Reader>
+    static String Decode(Reader& in)
+    {
+        uint64_t size = 0;
+        in.Read(&size, sizeof(size));
+        String item;
+        // Длину из поврежденного потока не резервируем целиком: строка растет по мере чтения
+        constexpr uint64_t piece = (size_t{ 1 } << 16) / sizeof(Char);
+        for (uint64_t done = 0; done < size;)
+        {
+            const size_t count = static_cast<size_t>(std::min(piece, size - done));
+            item.resize(static_cast<size_t>(done) + count);
+            in.Read(item.data() + done, count * sizeof(Char));
+            done += count;
+        }
+        return item;
+    }
+};
+
+namespace simple_vector_stream
+{
+
+// Чтение тривиальных элементов идет частями: размер вектора растет на CHUNK_BYTES за раз, чтобы
+// обнуление новой части при Resize оставалось в кэше до того, как ее перезапишет read
+constexpr size_t CHUNK_BYTES = size_t{ 1 } << 20;
+// Буфер кодируемых элементов
+constexpr size_t BUFFER_BYTES = size_t{ 1 } << 16;
+// write/read передают за вызов не больше ~2 ГиБ, поэтому куски writev ограничены 1 ГиБ
+constexpr size_t MAX_IO_BYTES = size_t{ 1 } << 30;
+
+[[noreturn]] inline void ThrowTruncated()
+{
+    throw std::runtime_error("Unexpected end of SimpleVector stream");
+}
+
+// Запись в файловый дескриптор
+class FdSink
+{
+public:
+    explicit FdSink(int fd) noexcept : fd_(fd)
+    {
+    }
+
+    void Write(const void* data, size_t size)
+    {
+        simple_vector_file::WriteAll(fd_, data, size);
+    }
+
+    // Записывает все части, повторяя writev после частичной записи и прерывания сигналом
+    void WriteVectored(iovec* parts, size_t count)
+    {
+        while (count > 0)
+        {
+            const int batch = static_cast<int>(std::min<size_t>(count, IOV_MAX));
+            ssize_t written = ::writev(fd_, parts, batch);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                simple_vector_file::ThrowSystemError("Cannot write SimpleVector data");
+            }
+            // Пропускаем записанные части целиком, у последней сдвигаем начало
+            while (count > 0 && static_cast<size_t>(written) >= parts->iov_len)
+            {
+                written -= static_cast<ssize_t>(parts->iov_len);
+                ++parts;
+                --count;
+            }
+            if (count > 0)
+            {
+                parts->iov_base = static_cast<char*>(parts->iov_base) + written;
+                parts->iov_len -= static_cast<size_t>(written);
+            }
+        }
+    }
+
+private:
+    int fd_;
+};
+
+// Запись в std::ostream
+class OstreamSink
+{
+public:
+    explicit OstreamSink(std::ostream& out) noexcept : out_(out)
+    {
+    }
+
+    void Write(const void* data, size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0)
+        {
+            const size_t part = std::min(size, MAX_IO_BYTES);
+            if (!out_.write(bytes, static_cast<std::streamsize>(part)))
+            {
+                throw std::runtime_error("Cannot write SimpleVector to stream");
+            }
+            bytes += part;
+            size -= part;
+        }
+    }
+
+    void WriteVectored(iovec* parts, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Write(parts[i].iov_base, parts[i].iov_len);
+        }
+    }
+
+private:
+    std::ostream& out_;
+};
+
+// Чтение из файлового дескриптора
+class FdSource
+{
+public:
+    explicit FdSource(int fd) noexcept : fd_(fd)
+    {
+    }
+
+    // Читает ровно size байт, повторяя read после частичного чтения и прерывания сигналом
+    void Read(void* data, size_t size)
+    {
+        char* bytes = static_cast<char*>(data);
+        while (size > 0)
+        {
+            const ssize_t received = ::read(fd_, bytes, std::min(size, MAX_IO_BYTES));
+            if (received < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                simple_vector_file::ThrowSystemError("Cannot read SimpleVector data");
+            }
+            if (received == 0)
+            {
+                ThrowTruncated();
+            }
+            bytes += received;
+            size -= static_cast<size_t>(received);
+        }
+    }
+
+private:
+    int fd_;
+};
+
+// Чтение из std::istream
+class IstreamSource
+{
+public:
+    explicit IstreamSource(std::istream& in) noexcept : in_(in)
+    {
+    }
+
+    void Read(void* data, size_t size)
+    {
+        char* bytes = static_cast<char*>(data);
+        while (size > 0)
+        {
+            const size_t part = std::min(size, MAX_IO_BYTES);
+            if (!in_.read(bytes, static_cast<std::streamsize>(part)))
+            {
+                ThrowTruncated();
+            }
+            bytes += part;
+            size -= part;
+        }
+    }
+
+private:
+    std::istream& in_;
+};
+
+// Кодированные элементы передаются кадрами: длина кадра (uint64_t), затем байты кадра.
+// Последовательность кадров завершается кадром нулевой длины, так что читатель знает, сколько байт
+// можно запросить, и не блокируется на канале в ожидании данных, которых не будет
+using FrameLength = uint64_t;
+
+// Накапливает мелкие записи кодека и передает их в Sink кадрами
+template <typename Sink>
+class FrameWriter
+{
+public:
+    explicit FrameWriter(Sink& sink) noexcept : sink_(sink)
+    {
+    }
+
+    void Write(const void* data, size_t size)
+    {
+        if (used_ + size > BUFFER_BYTES)
+        {
+            Flush();
+        }
+        if (size >= BUFFER_BYTES)
+        {
+            // Крупный кусок (например, длинная строка) уходит отдельным кадром без копирования
+            WriteFrame(data, size);
+            return;
+        }
+        std::memcpy(buffer_ + used_, data, size);
+        used_ += size;
+    }
+
+    // Передает накопленное и завершающий кадр
+    void Finish()
+    {
+        Flush();
+        const FrameLength end = 0;
+        sink_.Write(&end, sizeof(end));
+    }
+
+private:
+    Sink& sink_;
+    size_t used_ = 0;
+    char buffer_[BUFFER_BYTES];
+
+    void Flush()
+    {
+        if (used_ > 0)
+        {
+            WriteFrame(buffer_, used_);
+            used_ = 0;
+        }
+    }
+
+    void WriteFrame(const void* data, size_t size)
+    {
+        FrameLength length = size;
+        iovec parts[] = { { &length, sizeof(length) }, { const_cast<void*>(data), size } };
+        sink_.WriteVectored(parts, 2);
+    }
+};
+
+// Раздает байты кадров мелкими чтениями кодека. Из Source читается только содержимое кадров,
+// поэтому после завершающего кадра в Source не остается прочитанных лишних байт
+template <typename Source>
+class FrameReader
+{
+public:
+    explicit FrameReader(Source& source) noexcept : source_(source)
+    {
+    }
+
+    void Read(void* data, size_t size)
+    {
+        char* bytes = static_cast<char*>(data);
+        while (size > 0)
+        {
+            if (begin_ == end_)
+            {
+                if (frame_remaining_ == 0)
+                {
+                    NextFrame();
+                }
+                if (size >= BUFFER_BYTES)
+                {
+                    // Крупный кусок читается прямо в место назначения
+                    const size_t part = static_cast<size_t>(std::min<FrameLength>(size, frame_remaining_));
+                    source_.Read(bytes, part);
+                    frame_remaining_ -= part;
+                    bytes += part;
+                    size -= part;
+                    continue;
+                }
+                Fill();
+            }
+            const size_t part = std::min(size, end_ - begin_);
+            std::memcpy(bytes, buffer_ + begin_, part);
+            begin_ += part;
+            bytes += part;
+            size -= part;
+        }
+    }
+
+    // Проверяет, что все кадры прочитаны до завершающего
+    void Finish()
+    {
+        if (begin_ != end_ || frame_remaining_ != 0)
+        {
+            throw std::runtime_error("SimpleVector stream has undecoded element data");
+        }
+        FrameLength length = 0;
+        source_.Read(&length, sizeof(length));
+        if (length != 0)
+        {
+            throw std::runtime_error("SimpleVector stream has undecoded element data");
+        }
+    }
+
+private:
+    Source& source_;
+    FrameLength frame_remaining_ = 0;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+    char buffer_[BUFFER_BYTES];
+
+    void NextFrame()
+    {
+        source_.Read(&frame_remaining_, sizeof(frame_remaining_));
+        if (frame_remaining_ == 0)
+        {
+            // Завершающий кадр до того, как декодированы все элементы
+            ThrowTruncated();
+        }
+    }
+
+    void Fill()
+    {
+        const size_t size = static_cast<size_t>(std::min<FrameLength>(frame_remaining_, BUFFER_BYTES));
+        source_.Read(buffer_, size);
+        frame_remaining_ -= size;
+        begin_ = 0;
+        end_ = size;
+    }
+};
+
+// Заголовок потока: для тривиальных элементов - как у файла, для кодируемых - type_size == 0
+template <typename Type>
+SimpleVectorFileHeader StreamHeader(uint64_t count, uint64_t checksum) noexcept
+{
+    SimpleVectorFileHeader header = SimpleVectorFileHeader::For<Type>(count, checksum);
+    if constexpr (!std::is_trivially_copyable_v<Type>)
+    {
+        header.type_size = 0;
+        header.type_alignment = 0;
+        header.data_offset = SimpleVectorFileHeader::SIZE;
+    }
+    return header;
+}
+
+template <typename Sink, typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void Write(Sink& sink, const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items)
+{
+    constexpr bool raw = std::is_trivially_copyable_v<Type>;
+    const size_t bytes = raw ? items.GetSize() * sizeof(Type) : 0;
+    const SimpleVectorFileHeader header =
+        StreamHeader<Type>(items.GetSize(), raw ? SimpleVectorChecksum(items.cbegin(), bytes) : 0);
+    char prefix[SimpleVectorFileHeader::SIZE + alignof(Type)] = {};
+    std::memcpy(prefix, &header, sizeof(header));
+
+    if constexpr (raw)
+    {
+        // Заголовок и элементы уходят через writev прямо из хранилища вектора
+        iovec parts[64];
+        size_t count = 0;
+        parts[count++] = { prefix, static_cast<size_t>(header.data_offset) };
+        const char* data = reinterpret_cast<const char*>(items.cbegin());
+        for (size_t done = 0; done < bytes;)
+        {
+            if (count == std::size(parts))
+            {
+                sink.WriteVectored(parts, count);
+                count = 0;
+            }
+            const size_t part = std::min(bytes - done, MAX_IO_BYTES);
+            parts[count++] = { const_cast<char*>(data + done), part };
+            done += part;
+        }
+        sink.WriteVectored(parts, count);
+    }
+    else
+    {
+        sink.Write(prefix, header.data_offset);
+        FrameWriter<Sink> writer(sink);
+        for (const Type& item : items)
+        {
+            ElementCodec<Type>::Encode(writer, item);
+        }
+        writer.Finish();
+    }
+}
+
+template <typename Source, typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void Read(Source& source, SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items)
+{
+    constexpr bool raw = std::is_trivially_copyable_v<Type>;
+    SimpleVectorFileHeader header;
+    source.Read(&header, sizeof(header));
+    if constexpr (raw)
+    {
+        header.template Validate<Type>();
+    }
+    else
+    {
+        header.ValidateFormat();
+        if (header.type_size != 0 || header.data_offset != SimpleVectorFileHeader::SIZE)
+        {
+            throw std::runtime_error("SimpleVector stream element type mismatch: size "
+                                     + std::to_string(header.type_size));
+        }
+    }
+    char padding[SimpleVectorFileHeader::SIZE];
+    for (uint64_t skipped = sizeof(header); skipped < header.data_offset;)
+    {
+        const size_t part = static_cast<size_t>(std::min<uint64_t>(header.data_offset - skipped, sizeof(padding)));
+        source.Read(padding, part);
+        skipped += part;
+    }
+    if (header.count > SIZE_MAX / sizeof(Type))
+    {
+        throw std::runtime_error("SimpleVector stream is too large");
+    }
+
+    const size_t count = static_cast<size_t>(header.count);
+    items.Clear();
+    try
+    {
+        items.Reserve(count);
+        if constexpr (raw)
+        {
+            // Хранилище дорастает частями, и каждая часть читается прямо в него. Часть содержит
+            // кратное step число элементов, чтобы ее размер в байтах был кратен 8
+            constexpr size_t step = 8 / std::gcd(sizeof(Type), size_t{ 8 });
+            constexpr size_t chunk = std::max<size_t>(CHUNK_BYTES / sizeof(Type) / step, 1) * step;
+            uint64_t checksum = SimpleVectorChecksum(nullptr, 0);
+            for (size_t done = 0; done < count;)
+            {
+                const size_t part = std::min(count - done, chunk);
+                items.Resize(done + part);
+                source.Read(items.begin() + done, part * sizeof(Type));
+                // Все части, кроме последней, кратны 8 байтам, поэтому сумма продолжается через seed
+                checksum = SimpleVectorChecksum(items.cbegin() + done, part * sizeof(Type), checksum);
+                done += part;
+            }
+            if (checksum != header.checksum)
+            {
+                throw std::runtime_error("SimpleVector stream checksum mismatch");
+            }
+        }
+        else
+        {
+            FrameReader<Source> reader(source);
+            for (size_t i = 0; i < count; ++i)
+            {
+                items.PushBack(ElementCodec<Type>::Decode(reader));
+            }
+            reader.Finish();
+        }
+    }
+    catch (...)
+    {
+        items.Clear();
+        throw;
+    }
+}
+
+} // namespace simple_vector_stream
+
+// Записывает items в поток out. Поток не сбрасывается (flush)
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void WriteTo(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items, std::ostream& out)
+{
+    simple_vector_stream::OstreamSink sink(out);
+    simple_vector_stream::Write(sink, items);
+}
+
+// Записывает items в файловый дескриптор fd (файл, канал, сокет); дескриптор не закрывается
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void WriteTo(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items, int fd)
+{
+    simple_vector_stream::FdSink sink(fd);
+    simple_vector_stream::Write(sink, items);
+}
+
+// Заменяет содержимое items вектором, прочитанным из in. Читает ровно записанное WriteTo, так что
+// в одном потоке можно передавать несколько векторов подряд. При ошибке items остается пустым
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void ReadFrom(std::istream& in, SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items)
+{
+    simple_vector_stream::IstreamSource source(in);
+    simple_vector_stream::Read(source, items);
+}
+
+// То же для файлового дескриптора fd
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void ReadFrom(int fd, SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items)
+{
+    simple_vector_stream::FdSource source(fd);
+    simple_vector_stream::Read(source, items);
+}
@@ -0,0 +1,200 @@
+#pragma once
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+// Невладеющее представление непрерывного диапазона элементов (указатель и длина), аналог std::span.
+// Создается из SimpleVector (неявно), пары указателей или Subview другого представления и ничего
+// не копирует и не выделяет, поэтому части вектора можно передавать между компонентами по значению.
+// SimpleVectorView<const Type> дает только чтение, SimpleVectorView<Type> позволяет менять элементы
+// (но не размер). Представление действительно, пока жив вектор и он не перевыделил память:
+// после PushBack, Insert, Reserve и т.п. его нужно получить заново
+template <typename Type>
+class SimpleVectorView
+{
+    using Value = std::remove_cv_t<Type>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Значение count в Subview: до конца представления
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    SimpleVectorView() noexcept = default;
+
+    SimpleVectorView(Type* data, size_t size) noexcept : data_(data), size_(size)
+    {
+        assert(data != nullptr || size == 0);
+    }
+
+    // Шаблон, чтобы SimpleVectorView(ptr, 0) не был неоднозначен: 0 преобразуется и в size_t,
+    // и в нулевой указатель
+    template <typename Last, std::enable_if_t<std::is_convertible_v<Last, Type*> && !std::is_integral_v<Last>, int> = 0>
+    SimpleVectorView(Type* first, Last last) noexcept
+        : SimpleVectorView(first, static_cast<size_t>(static_cast<Type*>(last) - first))
+    {
+        assert(first <= static_cast<Type*>(last));
+    }
+
+    // Неявное преобразование из SimpleVector. Из константного вектора получается только
+    // SimpleVectorView<const Type>
+    template <typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+    SimpleVectorView(SimpleVector<Value, Allocator, GrowthPolicy, StatsPolicy>& items) noexcept
+        : data_(items.begin()), size_(items.GetSize())
+    {
+    }
+
+    template <typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename T = Type,
+              std::enable_if_t<std::is_const_v<T>, int> = 0>
+    SimpleVectorView(const SimpleVector<Value, Allocator, GrowthPolicy, StatsPolicy>& items) noexcept
+        : data_(items.cbegin()), size_(items.GetSize())
+    {
+    }
+
+    // SimpleVectorView<Type> -> SimpleVectorView<const Type>
+    template <typename Other, std::enable_if_t<std::is_same_v<const Other, Type> && !std::is_same_v<Other, Type>, int> = 0>
+    SimpleVectorView(const SimpleVectorView<Other>& other) noexcept : data_(other.begin()), size_(other.GetSize())
+    {
+    }
+
+    size_t GetSize() const noexcept
+    {
+        return size_;
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    Type* GetData() const noexcept
+    {
+        return data_;
+    }
+
+    Type& operator[](size_t index) const noexcept
+    {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator const At())");
+        }
+        return data_[index];
+    }
+
+    // Представление count элементов, начиная с offset (не больше, чем осталось до конца).
+    // Выбрасывает исключение std::out_of_range, если offset > size
+    SimpleVectorView Subview(size_t offset, size_t count = npos) const
+    {
+        if (offset > size_)
+        {
+            throw std::out_of_range("Offset is out of range (Subview())");
+        }
+        return SimpleVectorView(data_ + offset, std::min(count, size_ - offset));
+    }
+
+    Iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    Iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    // Копирует элементы в новый SimpleVector
+    template <typename Allocator = std::allocator<Value>>
+    SimpleVector<Value, Allocator> ToSimpleVector(const Allocator& alloc = Allocator()) const
+    {
+        SimpleVector<Value, Allocator> items(alloc);
+        items.Insert(items.cend(), cbegin(), cend());
+        return items;
+    }
+
+    // Операторы сравнения объявлены друзьями (не шаблонами), чтобы аргументы неявно
+    // преобразовывались: можно сравнивать представление с SimpleVector и
+    // SimpleVectorView<Type> с SimpleVectorView<const Type>
+    friend bool operator==(SimpleVectorView lhs, SimpleVectorView rhs)
+    {
+        if constexpr (simd::is_supported_v<Value>)
+        {
+            return lhs.size_ == rhs.size_ && simd::Mismatch(lhs.cbegin(), rhs.cbegin(), lhs.size_) == lhs.size_;
+        }
+        else
+        {
+            return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+        }
+    }
+
+    friend bool operator!=(SimpleVectorView lhs, SimpleVectorView rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(SimpleVectorView lhs, SimpleVectorView rhs)
+    {
+        if constexpr (simd::is_supported_v<Value>)
+        {
+            return simd::LexicographicalLess(lhs.cbegin(), lhs.size_, rhs.cbegin(), rhs.size_);
+        }
+        else
+        {
+            return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+        }
+    }
+
+    friend bool operator<=(SimpleVectorView lhs, SimpleVectorView rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>(SimpleVectorView lhs, SimpleVectorView rhs)
+    {
+        return rhs < lhs;
+    }
+
+    friend bool operator>=(SimpleVectorView lhs, SimpleVectorView rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Представление всех элементов вектора: MakeView(items) для изменяемых элементов,
+// MakeView(std::as_const(items)) - только для чтения
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+SimpleVectorView<Type> MakeView(SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items) noexcept
+{
+    return SimpleVectorView<Type>(items);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+SimpleVectorView<const Type> MakeView(const SimpleVector<Type, Allocator, GrowthPolicy, StatsPolicy>& items) noexcept
+{
+    return SimpleVectorView<const Type>(items);
+}
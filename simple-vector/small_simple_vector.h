@@ -0,0 +1,542 @@
+#pragma once
+#include "array_ptr.h"
+#include "simple_vector.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// Вектор с интерфейсом SimpleVector, хранящий до N элементов во встроенном буфере.
+// Память в куче (через Allocator) выделяется только когда размер превышает N
+template <typename Type, size_t N, typename Allocator = std::allocator<Type>>
+class SmallSimpleVector
+{
+    static_assert(N > 0, "Inline capacity must be positive");
+
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+
+    SmallSimpleVector() noexcept(noexcept(Allocator()))
+    {
+    }
+
+    explicit SmallSimpleVector(const Allocator& alloc) noexcept : heap_array_(alloc)
+    {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SmallSimpleVector(size_t size, const Allocator& alloc = Allocator()) : heap_array_(alloc)
+    {
+        Reserve(size);
+        heap_array_.UninitializedValueConstruct(data_, data_ + size);
+        size_ = size;
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SmallSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator()) : heap_array_(alloc)
+    {
+        Reserve(size);
+        heap_array_.UninitializedFill(data_, data_ + size, value);
+        size_ = size;
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SmallSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator()) : heap_array_(alloc)
+    {
+        Reserve(init.size());
+        heap_array_.UninitializedCopy(init.begin(), init.end(), data_);
+        size_ = init.size();
+    }
+
+    SmallSimpleVector(ReserveProxyObj obj, const Allocator& alloc = Allocator()) : heap_array_(alloc)
+    {
+        Reserve(obj.reserve_value);
+    }
+
+    SmallSimpleVector(const SmallSimpleVector& other)
+        : SmallSimpleVector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {
+    }
+
+    // Копирует элементы other, выделяя память (если нужна) распределителем alloc
+    SmallSimpleVector(const SmallSimpleVector& other, const Allocator& alloc) : heap_array_(alloc)
+    {
+        Reserve(other.size_);
+        heap_array_.UninitializedCopy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    // Распределитель rhs передается, только если propagate_on_container_copy_assignment,
+    // иначе копия строится в памяти распределителя *this
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+            {
+                if (GetAllocator() != rhs.GetAllocator())
+                {
+                    Clear();
+                    ResetAllocator(rhs.GetAllocator());
+                }
+            }
+            SmallSimpleVector tmp_rhs(rhs, GetAllocator());
+            *this = std::move(tmp_rhs);
+        }
+        return *this;
+    }
+
+    // Конструктор перемещения. Буфер в куче забирается целиком,
+    // элементы встроенного буфера перемещаются по одному
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>)
+        : heap_array_(other.GetAllocator())
+    {
+        TakeFrom(other);
+    }
+
+    // Буфер в куче забирается, если передается распределитель (propagate_on_container_move_assignment)
+    // или распределители равны; иначе элементы перемещаются по одному, и нужна новая память
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) noexcept(
+        (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+        && std::is_nothrow_move_constructible_v<Type>)
+    {
+        if (this != &rhs)
+        {
+            Clear();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+            {
+                if (GetAllocator() != rhs.GetAllocator())
+                {
+                    ResetAllocator(rhs.GetAllocator());
+                }
+            }
+            if (rhs.IsInline() || GetAllocator() == rhs.GetAllocator())
+            {
+                TakeFrom(rhs);
+            }
+            else
+            {
+                // Распределители различны: память rhs забрать нельзя, перемещаем поэлементно
+                Reserve(rhs.size_);
+                heap_array_.UninitializedMove(rhs.begin(), rhs.end(), data_);
+                size_ = rhs.size_;
+                rhs.Clear();
+            }
+        }
+        return *this;
+    }
+
+    ~SmallSimpleVector()
+    {
+        heap_array_.Destroy(begin(), end());
+    }
+
+    // Возвращает копию распределителя памяти
+    Allocator GetAllocator() const noexcept
+    {
+        return heap_array_.GetAllocator();
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept
+    {
+        return size_;
+    }
+
+    // Возвращает вместимость массива
+    size_t GetCapacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+    // Сообщает, находятся ли элементы во встроенном буфере
+    bool IsInline() const noexcept
+    {
+        return data_ == InlineData();
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept
+    {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index)
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator At())");
+        }
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator const At())");
+        }
+        return data_[index];
+    }
+
+    // Разрушает все элементы и обнуляет размер массива, не изменяя его вместимость
+    void Clear() noexcept
+    {
+        heap_array_.Destroy(begin(), end());
+        size_ = 0;
+    }
+
+    // Изменяет размер массива. Новые элементы получают значение по умолчанию,
+    // лишние элементы разрушаются
+    void Resize(size_t new_size)
+    {
+        if (new_size <= size_)
+        {
+            heap_array_.Destroy(begin() + new_size, end());
+            size_ = new_size;
+            return;
+        }
+
+        if (new_size > capacity_)
+        {
+            Reallocate(std::max(new_size, 2 * capacity_));
+        }
+        heap_array_.UninitializedValueConstruct(end(), begin() + new_size);
+        size_ = new_size;
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вдвое вместимость вектора
+    void PushBack(const Type& item)
+    {
+        if (size_ < capacity_)
+        {
+            heap_array_.Construct(end(), item);
+            ++size_;
+        }
+        else
+        {
+            ReallocateAndConstruct(size_, item);
+        }
+    }
+
+    // Добавляет элемент (rvalue) в конец вектора перемещением
+    void PushBack(Type&& item)
+    {
+        if (size_ < capacity_)
+        {
+            heap_array_.Construct(end(), std::move(item));
+            ++size_;
+        }
+        else
+        {
+            ReallocateAndConstruct(size_, std::move(item));
+        }
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value)
+    {
+        assert(pos >= begin() && pos <= end());
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+
+        if (size_ < capacity_)
+        {
+            // value может ссылаться на сдвигаемый элемент вектора, поэтому сначала копируем его
+            Type tmp_value(value);
+            InsertWithShift(offset, std::move(tmp_value));
+        }
+        else
+        {
+            ReallocateAndConstruct(offset, value);
+        }
+        return begin() + offset;
+    }
+
+    // Вставляет значение value (rvalue) в позицию pos перемещением.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, Type&& value)
+    {
+        assert(pos >= begin() && pos <= end());
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+
+        if (size_ < capacity_)
+        {
+            InsertWithShift(offset, std::move(value));
+        }
+        else
+        {
+            ReallocateAndConstruct(offset, std::move(value));
+        }
+        return begin() + offset;
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept
+    {
+        assert(!IsEmpty());
+        --size_;
+        heap_array_.Destroy(end(), end() + 1);
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    Iterator Erase(ConstIterator pos)
+    {
+        assert(pos >= begin() && pos < end());
+        Iterator it = begin() + (pos - cbegin());
+        std::move(it + 1, end(), it);
+        PopBack();
+        return it;
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SmallSimpleVector& other)
+    {
+        if (this == &other)
+        {
+            return;
+        }
+        if (!IsInline() && !other.IsInline())
+        {
+            heap_array_.swap(other.heap_array_);
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+            return;
+        }
+        SmallSimpleVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    // Увеличивает емкость вектора. Емкость не может быть меньше N
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity_)
+        {
+            Reallocate(new_capacity);
+        }
+    }
+
+    Iterator begin() noexcept
+    {
+        return data_;
+    }
+
+    Iterator end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return data_ + size_;
+    }
+
+private:
+    // Память в куче. Пуста, пока элементы помещаются во встроенный буфер.
+    // Через нее же выполняется конструирование элементов (распределитель)
+    ArrayPtr<Type, Allocator> heap_array_;
+    Type* data_ = InlineData();   // Начало текущего хранилища (встроенного или в куче)
+    size_t size_ = 0;             // Количество элементов в векторе
+    size_t capacity_ = N;         // Вместимость текущего хранилища
+
+    // Встроенный буфер под N элементов
+    alignas(Type) unsigned char inline_buffer_[N * sizeof(Type)];
+
+    Type* InlineData() noexcept
+    {
+        return reinterpret_cast<Type*>(inline_buffer_);
+    }
+
+    const Type* InlineData() const noexcept
+    {
+        return reinterpret_cast<const Type*>(inline_buffer_);
+    }
+
+    // Делает buffer текущим хранилищем. Элементы в нем уже сконструированы, старые разрушены
+    void AdoptHeapBuffer(ArrayPtr<Type, Allocator>& buffer, size_t new_capacity) noexcept
+    {
+        heap_array_.swap(buffer);
+        data_ = heap_array_.Get();
+        capacity_ = new_capacity;
+    }
+
+    // Перемещает элементы в буфер в куче емкостью new_capacity > N
+    void Reallocate(size_t new_capacity)
+    {
+        ArrayPtr<Type, Allocator> buffer(new_capacity, heap_array_.GetAllocator());
+        buffer.UninitializedMove(begin(), end(), buffer.Get());
+        heap_array_.Destroy(begin(), end());
+        AdoptHeapBuffer(buffer, new_capacity);
+    }
+
+    // Выделяет буфер удвоенной емкости, конструирует в нем новый элемент в позиции offset
+    // из args и перемещает вокруг него старые элементы
+    template <typename... Args>
+    void ReallocateAndConstruct(size_t offset, Args&&... args)
+    {
+        const size_t new_capacity = 2 * capacity_;
+        ArrayPtr<Type, Allocator> buffer(new_capacity, heap_array_.GetAllocator());
+        Type* new_item = buffer.Get() + offset;
+
+        // Новый элемент конструируется первым: args могут ссылаться на элементы вектора
+        buffer.Construct(new_item, std::forward<Args>(args)...);
+        try
+        {
+            buffer.UninitializedMove(begin(), begin() + offset, buffer.Get());
+            try
+            {
+                buffer.UninitializedMove(begin() + offset, end(), new_item + 1);
+            }
+            catch (...)
+            {
+                buffer.Destroy(buffer.Get(), new_item);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            buffer.Destroy(new_item, new_item + 1);
+            throw;
+        }
+
+        heap_array_.Destroy(begin(), end());
+        AdoptHeapBuffer(buffer, new_capacity);
+        ++size_;
+    }
+
+    // Вставляет value в позицию offset при size_ < capacity_, сдвигая хвост на одну позицию
+    void InsertWithShift(size_t offset, Type&& value)
+    {
+        if (offset == size_)
+        {
+            heap_array_.Construct(end(), std::move(value));
+        }
+        else
+        {
+            heap_array_.Construct(end(), std::move(*(end() - 1)));
+            std::move_backward(begin() + offset, end() - 1, end());
+            data_[offset] = std::move(value);
+        }
+        ++size_;
+    }
+
+    // Возвращает пустой вектор во встроенный буфер: память отдается прежнему распределителю,
+    // после чего он заменяется на alloc
+    void ResetAllocator(const Allocator& alloc)
+    {
+        assert(size_ == 0);
+        heap_array_.ResetAllocator(alloc);
+        data_ = InlineData();
+        capacity_ = N;
+    }
+
+    // Забирает содержимое other в пустой *this с равным распределителем
+    void TakeFrom(SmallSimpleVector& other)
+    {
+        assert(size_ == 0);
+        if (other.IsInline())
+        {
+            if (!IsInline())
+            {
+                // Свой буфер в куче больше не нужен, возвращаемся во встроенный
+                ArrayPtr<Type, Allocator> empty(heap_array_.GetAllocator());
+                AdoptHeapBuffer(empty, N);
+                data_ = InlineData();
+            }
+            heap_array_.UninitializedMove(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.Clear();
+        }
+        else
+        {
+            heap_array_.swap(other.heap_array_);
+            data_ = heap_array_.Get();
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, N);
+            other.data_ = other.InlineData();
+            // Освобождаем буфер, доставшийся other от *this (если он был)
+            ArrayPtr<Type, Allocator> empty(other.heap_array_.GetAllocator());
+            other.heap_array_.swap(empty);
+        }
+    }
+};
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator==(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs)
+{
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator!=(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator<(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs)
+{
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator<=(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator>(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator>=(const SmallSimpleVector<Type, N, Allocator>& lhs, const SmallSimpleVector<Type, N, Allocator>& rhs)
+{
+    return !(lhs < rhs);
+}
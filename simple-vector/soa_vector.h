@@ -0,0 +1,521 @@
+#pragma once
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "simple_vector_view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+template <typename Owner>
+class SoaRow;
+
+// Вектор записей из полей Types..., хранящий каждое поле в отдельном массиве (structure of arrays).
+// Проход по одному-двум полям читает только их массивы, и каждая загруженная строка кэша целиком
+// состоит из нужных значений; непрерывные столбцы Column<I>() удобны для SIMD-ядер.
+// Все столбцы имеют общие размер и емкость и растут вместе по политике GrowthPolicy (размер
+// элемента для политики - сумма размеров полей). operator[] возвращает прокси строки SoaRow
+// со ссылками на поля; структурное связывание auto [a, b] = v[i] дает ссылки на элементы столбцов.
+// Столбцы и прокси строк становятся недействительными после перевыделения памяти.
+// Insert и Erase сдвигают столбцы по очереди, поэтому перемещение полей не должно выбрасывать
+// исключений (иначе строки разошлись бы между столбцами): поля - тривиально перемещаемые типы
+// или типы с noexcept перемещающими конструктором и присваиванием. При исключении в PushBack,
+// Insert, Resize или копировании вектор остается согласованным: недостроенная строка разрушается
+template <typename GrowthPolicy, typename... Types>
+class BasicSoaVector
+{
+    static_assert(sizeof...(Types) > 0, "SoaVector needs at least one column");
+    static_assert(((is_trivially_relocatable_v<Types>
+                    || (std::is_nothrow_move_constructible_v<Types> && std::is_nothrow_move_assignable_v<Types>)) && ...),
+                  "SoaVector columns must be trivially relocatable or nothrow movable");
+
+    using Columns = std::tuple<ArrayPtr<Types>...>;
+    using Indices = std::index_sequence_for<Types...>;
+
+    // Суммарный размер строки для политики роста
+    static constexpr size_t ROW_SIZE = (sizeof(Types) + ...);
+
+public:
+    template <size_t I>
+    using ColumnType = std::tuple_element_t<I, std::tuple<Types...>>;
+
+    using Row = SoaRow<BasicSoaVector>;
+    using ConstRow = SoaRow<const BasicSoaVector>;
+    using GrowthPolicyType = GrowthPolicy;
+
+    static constexpr size_t COLUMN_COUNT = sizeof...(Types);
+
+    BasicSoaVector() noexcept = default;
+
+    // Создает вектор из size строк со значениями по умолчанию
+    explicit BasicSoaVector(size_t size)
+    {
+        Resize(size);
+    }
+
+    BasicSoaVector(const BasicSoaVector& other)
+    {
+        Reserve(other.size_);
+        CopyColumns(other, Indices{});
+        size_ = other.size_;
+    }
+
+    BasicSoaVector& operator=(const BasicSoaVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            BasicSoaVector tmp_rhs(rhs);
+            swap(tmp_rhs);
+        }
+        return *this;
+    }
+
+    BasicSoaVector(BasicSoaVector&& other) noexcept
+        : columns_(std::move(other.columns_))
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0))
+    {
+    }
+
+    BasicSoaVector& operator=(BasicSoaVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            BasicSoaVector tmp_rhs(std::move(rhs));
+            swap(tmp_rhs);
+        }
+        return *this;
+    }
+
+    ~BasicSoaVector()
+    {
+        DestroyRows(0, size_, Indices{});
+    }
+
+    size_t GetSize() const noexcept
+    {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    bool IsEmpty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // Прокси строки index (ссылки на поля)
+    Row operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        return Row(*this, index);
+    }
+
+    ConstRow operator[](size_t index) const noexcept
+    {
+        assert(index < size_);
+        return ConstRow(*this, index);
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Row At(size_t index)
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator At())");
+        }
+        return Row(*this, index);
+    }
+
+    ConstRow At(size_t index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("Index is out of range (operator const At())");
+        }
+        return ConstRow(*this, index);
+    }
+
+    // Столбец I: непрерывный массив значений I-го поля всех строк
+    template <size_t I>
+    SimpleVectorView<ColumnType<I>> Column() noexcept
+    {
+        return SimpleVectorView<ColumnType<I>>(std::get<I>(columns_).Get(), size_);
+    }
+
+    template <size_t I>
+    SimpleVectorView<const ColumnType<I>> Column() const noexcept
+    {
+        return SimpleVectorView<const ColumnType<I>>(std::get<I>(columns_).Get(), size_);
+    }
+
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity_)
+        {
+            Reallocate(new_capacity, Indices{});
+        }
+    }
+
+    // Изменяет количество строк; новые строки получают значения по умолчанию
+    void Resize(size_t new_size)
+    {
+        if (new_size <= size_)
+        {
+            DestroyRows(new_size, size_, Indices{});
+            size_ = new_size;
+            return;
+        }
+        if (new_size > capacity_)
+        {
+            Reallocate(NextCapacity(new_size), Indices{});
+        }
+        for (; size_ < new_size; ++size_)
+        {
+            ConstructRow(size_, Indices{});
+        }
+    }
+
+    void Clear() noexcept
+    {
+        DestroyRows(0, size_, Indices{});
+        size_ = 0;
+    }
+
+    // Добавляет строку в конец: fields - по одному значению на каждый столбец
+    template <typename... Args>
+    void PushBack(Args&&... fields)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Types), "PushBack needs one value per column");
+        if (size_ == capacity_)
+        {
+            // fields могут ссылаться на элементы вектора, которые переедут при перевыделении,
+            // поэтому строка сначала создается во временном объекте
+            std::tuple<Types...> row(std::forward<Args>(fields)...);
+            Reallocate(NextCapacity(size_ + 1), Indices{});
+            ConstructRowFromTuple(size_, std::move(row), Indices{});
+        }
+        else
+        {
+            ConstructRow(size_, Indices{}, std::forward<Args>(fields)...);
+        }
+        ++size_;
+    }
+
+    void PopBack() noexcept
+    {
+        assert(size_ > 0);
+        DestroyRows(size_ - 1, size_, Indices{});
+        --size_;
+    }
+
+    // Вставляет строку в позицию index (0 <= index <= size) и сдвигает хвост во всех столбцах
+    template <typename... Args>
+    void Insert(size_t index, Args&&... fields)
+    {
+        assert(index <= size_);
+        PushBack(std::forward<Args>(fields)...);
+        RotateLastTo(index, Indices{});
+    }
+
+    // Удаляет строку index
+    void Erase(size_t index)
+    {
+        assert(index < size_);
+        Erase(index, index + 1);
+    }
+
+    // Удаляет строки [first, last), сдвигая хвост во всех столбцах
+    void Erase(size_t first, size_t last)
+    {
+        assert(first <= last && last <= size_);
+        if (first != last)
+        {
+            EraseRows(first, last, Indices{});
+            size_ -= last - first;
+        }
+    }
+
+    void swap(BasicSoaVector& other) noexcept
+    {
+        SwapColumns(other, Indices{});
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+private:
+    Columns columns_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+
+    size_t NextCapacity(size_t required) const noexcept
+    {
+        return GrowthPolicy::NextCapacity(capacity_, required, ROW_SIZE);
+    }
+
+    // Переносит каждый столбец в буфер емкостью new_capacity. Если выделение памяти для столбца
+    // выбросило исключение, уже перенесенные столбцы остаются в больших буферах: это допустимо,
+    // общая емкость capacity_ - не больше емкости любого столбца
+    template <size_t... I>
+    void Reallocate(size_t new_capacity, std::index_sequence<I...>)
+    {
+        (ReallocateColumn(std::get<I>(columns_), new_capacity), ...);
+        capacity_ = new_capacity;
+    }
+
+    template <typename Type>
+    void ReallocateColumn(ArrayPtr<Type>& column, size_t new_capacity)
+    {
+        if (column.GetSize() >= new_capacity)
+        {
+            return;
+        }
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            column.Reallocate(new_capacity, size_);
+        }
+        else
+        {
+            ArrayPtr<Type> buffer(new_capacity, column.GetAllocator());
+            buffer.UninitializedMove(column.Get(), column.Get() + size_, buffer.Get());
+            column.Destroy(column.Get(), column.Get() + size_);
+            column.swap(buffer);
+        }
+    }
+
+    // Конструирует строку index в неинициализированной памяти всех столбцов. Если конструктор
+    // поля выбросил исключение, уже созданные поля строки разрушаются
+    template <size_t... I, typename... Args>
+    void ConstructRow(size_t index, std::index_sequence<I...>, Args&&... fields)
+    {
+        size_t constructed = 0;
+        try
+        {
+            if constexpr (sizeof...(Args) == 0)
+            {
+                ((std::get<I>(columns_).Construct(std::get<I>(columns_).Get() + index), ++constructed), ...);
+            }
+            else
+            {
+                ((std::get<I>(columns_).Construct(std::get<I>(columns_).Get() + index, std::forward<Args>(fields)),
+                  ++constructed), ...);
+            }
+        }
+        catch (...)
+        {
+            ((I < constructed ? std::get<I>(columns_).Destroy(std::get<I>(columns_).Get() + index,
+                                                              std::get<I>(columns_).Get() + index + 1)
+                              : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void ConstructRowFromTuple(size_t index, std::tuple<Types...>&& row, std::index_sequence<I...> indices)
+    {
+        ConstructRow(index, indices, std::move(std::get<I>(row))...);
+    }
+
+    template <size_t... I>
+    void CopyColumns(const BasicSoaVector& other, std::index_sequence<I...>)
+    {
+        size_t copied = 0;
+        try
+        {
+            ((std::get<I>(columns_).UninitializedCopy(std::get<I>(other.columns_).Get(),
+                                                      std::get<I>(other.columns_).Get() + other.size_,
+                                                      std::get<I>(columns_).Get()),
+              ++copied), ...);
+        }
+        catch (...)
+        {
+            ((I < copied ? std::get<I>(columns_).Destroy(std::get<I>(columns_).Get(),
+                                                         std::get<I>(columns_).Get() + other.size_)
+                         : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void DestroyRows(size_t first, size_t last, std::index_sequence<I...>) noexcept
+    {
+        (std::get<I>(columns_).Destroy(std::get<I>(columns_).Get() + first, std::get<I>(columns_).Get() + last), ...);
+    }
+
+    template <size_t... I>
+    void EraseRows(size_t first, size_t last, std::index_sequence<I...>)
+    {
+        (EraseColumnRows(std::get<I>(columns_), first, last), ...);
+    }
+
+    template <typename Type>
+    void EraseColumnRows(ArrayPtr<Type>& column, size_t first, size_t last)
+    {
+        Type* data = column.Get();
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            // Удаляемые элементы разрушаются, хвост сдвигается одним memmove
+            column.Destroy(data + first, data + last);
+            ArrayPtr<Type>::RawShift(data + last, size_ - last, data + first);
+        }
+        else
+        {
+            Type* new_end = std::move(data + last, data + size_, data + first);
+            column.Destroy(new_end, data + size_);
+        }
+    }
+
+    // Переносит последнюю строку в позицию index, сдвигая строки [index, size - 1) на одну вперед
+    template <size_t... I>
+    void RotateLastTo(size_t index, std::index_sequence<I...>)
+    {
+        (RotateColumn(std::get<I>(columns_), index), ...);
+    }
+
+    template <typename Type>
+    void RotateColumn(ArrayPtr<Type>& column, size_t index)
+    {
+        Type* data = column.Get();
+        const size_t last = size_ - 1;
+        if (index == last)
+        {
+            return;
+        }
+        if constexpr (is_trivially_relocatable_v<Type>)
+        {
+            // Последний элемент побайтно откладывается, хвост сдвигается memmove, элемент кладется на место
+            alignas(Type) unsigned char item[sizeof(Type)];
+            std::memcpy(item, static_cast<const void*>(data + last), sizeof(Type));
+            ArrayPtr<Type>::RawShift(data + index, last - index, data + index + 1);
+            std::memcpy(static_cast<void*>(data + index), item, sizeof(Type));
+        }
+        else
+        {
+            std::rotate(data + index, data + last, data + size_);
+        }
+    }
+
+    template <size_t... I>
+    void SwapColumns(BasicSoaVector& other, std::index_sequence<I...>) noexcept
+    {
+        (std::get<I>(columns_).swap(std::get<I>(other.columns_)), ...);
+    }
+};
+
+template <typename... Types>
+using SoaVector = BasicSoaVector<DoublingGrowth, Types...>;
+
+// Прокси строки BasicSoaVector (Owner - вектор или константный вектор): номер строки и
+// указатель на вектор. Get<I>() возвращает ссылку на I-е поле, присваивание строке или кортежу
+// присваивает поля, преобразование в std::tuple копирует значения полей
+template <typename Owner>
+class SoaRow
+{
+    using Vector = std::remove_const_t<Owner>;
+    using Indices = std::make_index_sequence<Vector::COLUMN_COUNT>;
+
+    template <size_t I>
+    using FieldType = typename Vector::template ColumnType<I>;
+
+public:
+    SoaRow(Owner& owner, size_t index) noexcept : owner_(&owner), index_(index)
+    {
+    }
+
+    SoaRow(const SoaRow&) noexcept = default;
+
+    // Присваивает полям строки значения полей другой строки
+    SoaRow& operator=(const SoaRow& other)
+    {
+        Assign(other, Indices{});
+        return *this;
+    }
+
+    template <typename Other>
+    SoaRow& operator=(const SoaRow<Other>& other)
+    {
+        Assign(other, Indices{});
+        return *this;
+    }
+
+    template <typename... Values>
+    SoaRow& operator=(const std::tuple<Values...>& values)
+    {
+        AssignTuple(values, Indices{});
+        return *this;
+    }
+
+    template <size_t I>
+    decltype(auto) Get() const noexcept
+    {
+        return owner_->template Column<I>()[index_];
+    }
+
+    size_t GetIndex() const noexcept
+    {
+        return index_;
+    }
+
+    template <typename O = Owner, std::enable_if_t<!std::is_const_v<O>, int> = 0>
+    operator SoaRow<const O>() const noexcept
+    {
+        return SoaRow<const O>(*owner_, index_);
+    }
+
+    template <typename... Types>
+    operator std::tuple<Types...>() const
+    {
+        return ToTuple<Types...>(Indices{});
+    }
+
+private:
+    Owner* owner_;
+    size_t index_;
+
+    template <typename Other, size_t... I>
+    void Assign(const SoaRow<Other>& other, std::index_sequence<I...>)
+    {
+        ((Get<I>() = other.template Get<I>()), ...);
+    }
+
+    template <typename Tuple, size_t... I>
+    void AssignTuple(const Tuple& values, std::index_sequence<I...>)
+    {
+        ((Get<I>() = std::get<I>(values)), ...);
+    }
+
+    template <typename... Types, size_t... I>
+    std::tuple<Types...> ToTuple(std::index_sequence<I...>) const
+    {
+        return std::tuple<Types...>(Get<I>()...);
+    }
+};
+
+// Доступ к полю по номеру для структурного связывания: auto [id, score] = items[i]
+template <size_t I, typename Owner>
+decltype(auto) get(const SoaRow<Owner>& row) noexcept
+{
+    return row.template Get<I>();
+}
+
+namespace std
+{
+template <typename Owner>
+struct tuple_size<SoaRow<Owner>> : std::integral_constant<size_t, std::remove_const_t<Owner>::COLUMN_COUNT>
+{
+};
+
+template <size_t I, typename Owner>
+struct tuple_element<I, SoaRow<Owner>>
+{
+    using type = decltype(std::declval<const SoaRow<Owner>&>().template Get<I>());
+};
+} // namespace std
@@ -0,0 +1,484 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace static_vector_detail
+{
+
+// Хранилище StaticVector для тривиальных типов: обычный массив, инициализированный нулями.
+// Такой StaticVector - литеральный тип, и его можно заполнять в constexpr-функциях (C++17)
+template <typename Type, size_t N, bool = std::is_trivial_v<Type>>
+struct Storage
+{
+    Type items[N]{};
+    size_t size = 0;
+
+    constexpr Type* Data() noexcept
+    {
+        return items;
+    }
+
+    constexpr const Type* Data() const noexcept
+    {
+        return items;
+    }
+
+    template <typename... Args>
+    constexpr void Construct(size_t index, Args&&... args)
+    {
+        items[index] = Type(std::forward<Args>(args)...);
+    }
+
+    constexpr void Destroy(size_t /*first*/, size_t /*last*/) noexcept
+    {
+    }
+};
+
+// Хранилище для прочих типов: неинициализированная память, элементы конструируются на месте
+// и разрушаются деструктором хранилища
+template <typename Type, size_t N>
+struct Storage<Type, N, false>
+{
+    alignas(Type) unsigned char bytes[N * sizeof(Type)];
+    size_t size = 0;
+
+    Storage() noexcept
+    {
+    }
+
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    ~Storage()
+    {
+        Destroy(0, size);
+    }
+
+    Type* Data() noexcept
+    {
+        return std::launder(reinterpret_cast<Type*>(bytes));
+    }
+
+    const Type* Data() const noexcept
+    {
+        return std::launder(reinterpret_cast<const Type*>(bytes));
+    }
+
+    template <typename... Args>
+    void Construct(size_t index, Args&&... args)
+    {
+        ::new (static_cast<void*>(bytes + index * sizeof(Type))) Type(std::forward<Args>(args)...);
+    }
+
+    void Destroy(size_t first, size_t last) noexcept
+    {
+        for (Type* item = Data() + first; item != Data() + last; ++item)
+        {
+            item->~Type();
+        }
+    }
+};
+
+} // namespace static_vector_detail
+
+// Вектор с интерфейсом SimpleVector и емкостью, фиксированной на этапе компиляции: до N элементов
+// хранятся прямо в объекте, куча и распределитель не используются. Превышение емкости
+// (PushBack, Insert, Resize, Reserve больше N) выбрасывает std::length_error.
+// Для тривиальных типов (int, double, POD-структуры) все методы constexpr, поэтому таблицы можно
+// строить и проверять при компиляции и встраивать в двоичный файл:
+//     constexpr StaticVector<int, 16> table = MakeTable();
+// Ценой этого свободная часть буфера тривиальных типов обнуляется при создании вектора.
+// Алгоритмы стандартной библиотеки в C++17 не constexpr, поэтому сдвиги и сравнения написаны циклами
+template <typename Type, size_t N>
+class StaticVector
+{
+    static_assert(N > 0, "Capacity must be positive");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    constexpr StaticVector() noexcept = default;
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    constexpr explicit StaticVector(size_t size)
+    {
+        Resize(size);
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    constexpr StaticVector(size_t size, const Type& value)
+    {
+        CheckCapacity(size);
+        while (storage_.size < size)
+        {
+            EmplaceBack(value);
+        }
+    }
+
+    // Создаёт вектор из std::initializer_list
+    constexpr StaticVector(std::initializer_list<Type> init)
+    {
+        CheckCapacity(init.size());
+        for (const Type& item : init)
+        {
+            EmplaceBack(item);
+        }
+    }
+
+    constexpr StaticVector(const StaticVector& other)
+    {
+        for (const Type& item : other)
+        {
+            EmplaceBack(item);
+        }
+    }
+
+    constexpr StaticVector& operator=(const StaticVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            StaticVector tmp_rhs(rhs);
+            swap(tmp_rhs);
+        }
+        return *this;
+    }
+
+    // Перемещение поэлементное: буфер встроен в объект, и забрать его целиком нельзя
+    constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>)
+    {
+        for (Type& item : other)
+        {
+            EmplaceBack(std::move(item));
+        }
+        other.Clear();
+    }
+
+    constexpr StaticVector& operator=(StaticVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>
+                                                                 && std::is_nothrow_move_assignable_v<Type>
+                                                                 && std::is_nothrow_swappable_v<Type>)
+    {
+        if (this != &rhs)
+        {
+            Clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    // Возвращает количество элементов в массиве
+    constexpr size_t GetSize() const noexcept
+    {
+        return storage_.size;
+    }
+
+    // Возвращает вместимость массива (всегда N)
+    static constexpr size_t GetCapacity() noexcept
+    {
+        return N;
+    }
+
+    // Сообщает, пустой ли массив
+    constexpr bool IsEmpty() const noexcept
+    {
+        return storage_.size == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    constexpr Type& operator[](size_t index) noexcept
+    {
+        assert(index < storage_.size);
+        return storage_.Data()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    constexpr const Type& operator[](size_t index) const noexcept
+    {
+        assert(index < storage_.size);
+        return storage_.Data()[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    constexpr Type& At(size_t index)
+    {
+        if (index >= storage_.size)
+        {
+            throw std::out_of_range("Index is out of range (operator At())");
+        }
+        return storage_.Data()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    constexpr const Type& At(size_t index) const
+    {
+        if (index >= storage_.size)
+        {
+            throw std::out_of_range("Index is out of range (operator const At())");
+        }
+        return storage_.Data()[index];
+    }
+
+    // Разрушает все элементы и обнуляет размер массива
+    constexpr void Clear() noexcept
+    {
+        storage_.Destroy(0, storage_.size);
+        storage_.size = 0;
+    }
+
+    // Изменяет размер массива. Новые элементы получают значение по умолчанию,
+    // лишние элементы разрушаются
+    constexpr void Resize(size_t new_size)
+    {
+        if (new_size <= storage_.size)
+        {
+            storage_.Destroy(new_size, storage_.size);
+            storage_.size = new_size;
+            return;
+        }
+        CheckCapacity(new_size);
+        while (storage_.size < new_size)
+        {
+            EmplaceBack();
+        }
+    }
+
+    // Проверяет, что в массиве поместятся capacity элементов. Память уже выделена,
+    // метод нужен для совместимости с SimpleVector
+    constexpr void Reserve(size_t capacity) const
+    {
+        CheckCapacity(capacity);
+    }
+
+    // Конструирует элемент в конце вектора из args и возвращает ссылку на него
+    template <typename... Args>
+    constexpr Type& EmplaceBack(Args&&... args)
+    {
+        CheckCapacity(storage_.size + 1);
+        storage_.Construct(storage_.size, std::forward<Args>(args)...);
+        return storage_.Data()[storage_.size++];
+    }
+
+    // Добавляет элемент в конец вектора
+    constexpr void PushBack(const Type& item)
+    {
+        EmplaceBack(item);
+    }
+
+    // Добавляет элемент (rvalue) в конец вектора перемещением
+    constexpr void PushBack(Type&& item)
+    {
+        EmplaceBack(std::move(item));
+    }
+
+    // Конструирует элемент из args в позиции pos, сдвигая хвост.
+    // Возвращает итератор на вставленное значение
+    template <typename... Args>
+    constexpr Iterator Emplace(ConstIterator pos, Args&&... args)
+    {
+        assert(pos >= cbegin() && pos <= cend());
+        const size_t offset = static_cast<size_t>(pos - cbegin());
+        if (offset == storage_.size)
+        {
+            EmplaceBack(std::forward<Args>(args)...);
+            return begin() + offset;
+        }
+        CheckCapacity(storage_.size + 1);
+
+        // Значение создается до сдвига: args могут ссылаться на элементы вектора.
+        // Последний элемент переезжает за конец, остальные сдвигаются присваиванием перемещением
+        Type value(std::forward<Args>(args)...);
+        Type* items = storage_.Data();
+        storage_.Construct(storage_.size, std::move(items[storage_.size - 1]));
+        ++storage_.size;
+        for (size_t i = storage_.size - 2; i > offset; --i)
+        {
+            items[i] = std::move(items[i - 1]);
+        }
+        items[offset] = std::move(value);
+        return begin() + offset;
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    constexpr Iterator Insert(ConstIterator pos, const Type& value)
+    {
+        return Emplace(pos, value);
+    }
+
+    constexpr Iterator Insert(ConstIterator pos, Type&& value)
+    {
+        return Emplace(pos, std::move(value));
+    }
+
+    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
+    constexpr void PopBack() noexcept
+    {
+        assert(storage_.size > 0);
+        storage_.Destroy(storage_.size - 1, storage_.size);
+        --storage_.size;
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    constexpr Iterator Erase(ConstIterator pos)
+    {
+        assert(pos >= cbegin() && pos < cend());
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост присваиванием перемещением.
+    // Возвращает итератор на элемент, следовавший за удаленными
+    constexpr Iterator Erase(ConstIterator first, ConstIterator last)
+    {
+        assert(cbegin() <= first && first <= last && last <= cend());
+        const size_t offset = static_cast<size_t>(first - cbegin());
+        const size_t count = static_cast<size_t>(last - first);
+        if (count != 0)
+        {
+            Type* items = storage_.Data();
+            for (size_t i = offset; i + count < storage_.size; ++i)
+            {
+                items[i] = std::move(items[i + count]);
+            }
+            storage_.Destroy(storage_.size - count, storage_.size);
+            storage_.size -= count;
+        }
+        return begin() + offset;
+    }
+
+    // Обменивает значение с другим вектором: общая часть обменивается поэлементно,
+    // остаток более длинного вектора перемещается в более короткий
+    constexpr void swap(StaticVector& other)
+    {
+        StaticVector& longer = storage_.size >= other.storage_.size ? *this : other;
+        StaticVector& shorter = storage_.size >= other.storage_.size ? other : *this;
+        const size_t common = shorter.storage_.size;
+        for (size_t i = 0; i < common; ++i)
+        {
+            Type tmp(std::move(shorter[i]));
+            shorter[i] = std::move(longer[i]);
+            longer[i] = std::move(tmp);
+        }
+        for (size_t i = common; i < longer.storage_.size; ++i)
+        {
+            shorter.EmplaceBack(std::move(longer[i]));
+        }
+        longer.storage_.Destroy(common, longer.storage_.size);
+        longer.storage_.size = common;
+    }
+
+    constexpr Iterator begin() noexcept
+    {
+        return storage_.Data();
+    }
+
+    constexpr Iterator end() noexcept
+    {
+        return storage_.Data() + storage_.size;
+    }
+
+    constexpr ConstIterator begin() const noexcept
+    {
+        return storage_.Data();
+    }
+
+    constexpr ConstIterator end() const noexcept
+    {
+        return storage_.Data() + storage_.size;
+    }
+
+    constexpr ConstIterator cbegin() const noexcept
+    {
+        return storage_.Data();
+    }
+
+    constexpr ConstIterator cend() const noexcept
+    {
+        return storage_.Data() + storage_.size;
+    }
+
+private:
+    static_vector_detail::Storage<Type, N> storage_;
+
+    // Выбрасывает std::length_error, если size > N. При вычислении во время компиляции
+    // выброс исключения делает выражение неконстантным, и переполнение становится ошибкой компиляции.
+    // Сравнение встраивается в место вызова, а выброс вынесен в отдельную функцию: так компилятор
+    // видит, что после проверки индекс меньше N, и не предупреждает о выходе за границы items
+    static constexpr void CheckCapacity(size_t size)
+    {
+        if (size > N)
+        {
+            ThrowCapacityExceeded();
+        }
+    }
+
+    [[noreturn]] static constexpr void ThrowCapacityExceeded()
+    {
+        throw std::length_error("StaticVector capacity exceeded");
+    }
+};
+
+template <typename Type, size_t N>
+constexpr bool operator==(const StaticVector<Type, N>& lhs, const StaticVector<Type, N>& rhs)
+{
+    if (lhs.GetSize() != rhs.GetSize())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.GetSize(); ++i)
+    {
+        if (!(lhs[i] == rhs[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Type, size_t N>
+constexpr bool operator!=(const StaticVector<Type, N>& lhs, const StaticVector<Type, N>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+constexpr bool operator<(const StaticVector<Type, N>& lhs, const StaticVector<Type, N>& rhs)
+{
+    for (size_t i = 0; i < lhs.GetSize() && i < rhs.GetSize(); ++i)
+    {
+        if (lhs[i] < rhs[i])
+        {
+            return true;
+        }
+        if (rhs[i] < lhs[i])
+        {
+            return false;
+        }
+    }
+    return lhs.GetSize() < rhs.GetSize();
+}
+
+template <typename Type, size_t N>
+constexpr bool operator<=(const StaticVector<Type, N>& lhs, const StaticVector<Type, N>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+constexpr bool operator>(const StaticVector<Type, N>& lhs, const StaticVector<Type, N>& rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N>
+constexpr bool operator>=(const StaticVector<Type, N>& lhs, const StaticVector<Type, N>& rhs)
+{
+    return !(lhs < rhs);
+}
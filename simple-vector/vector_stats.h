@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+// Счетчики одного вектора (или снимок агрегированных счетчиков типа элементов)
+struct VectorStatsCounters
+{
+    size_t allocations = 0;         // Выделений буфера
+    size_t deallocations = 0;       // Освобождений буфера
+    size_t growths = 0;             // Увеличений емкости (переездов в новый буфер)
+    size_t shrinks = 0;             // Уменьшений емкости (ShrinkToFit или политикой роста)
+    size_t peak_capacity = 0;       // Максимальная емкость (элементов)
+    size_t elements_copied = 0;     // Скопировано элементов
+    size_t elements_moved = 0;      // Перемещено элементов (сдвиги в Insert/Erase и переезды при росте)
+    size_t bytes_copied = 0;
+    size_t bytes_moved = 0;
+    size_t wasted_capacity = 0;     // capacity - size: у вектора текущая, у типа - накопленная при разрушении векторов
+    size_t destroyed_vectors = 0;   // Только для агрегированных счетчиков
+};
+
+// Агрегированные по типу элементов счетчики. Обновляются из разных потоков
+class AggregateVectorStats
+{
+public:
+    explicit AggregateVectorStats(std::string type_name) : type_name_(std::move(type_name))
+    {
+    }
+
+    const std::string& GetTypeName() const noexcept
+    {
+        return type_name_;
+    }
+
+    void OnAllocate(size_t capacity) noexcept
+    {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+        while (capacity > peak && !peak_capacity_.compare_exchange_weak(peak, capacity, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void OnDeallocate() noexcept
+    {
+        deallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnGrowth() noexcept
+    {
+        growths_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnShrink() noexcept
+    {
+        shrinks_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void OnCopy(size_t count, size_t bytes) noexcept
+    {
+        elements_copied_.fetch_add(count, std::memory_order_relaxed);
+        bytes_copied_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void OnMove(size_t count, size_t bytes) noexcept
+    {
+        elements_moved_.fetch_add(count, std::memory_order_relaxed);
+        bytes_moved_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void OnDestroy(size_t wasted_capacity) noexcept
+    {
+        wasted_capacity_.fetch_add(wasted_capacity, std::memory_order_relaxed);
+        destroyed_vectors_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    VectorStatsCounters GetCounters() const noexcept
+    {
+        VectorStatsCounters counters;
+        counters.allocations = allocations_.load(std::memory_order_relaxed);
+        counters.deallocations = deallocations_.load(std::memory_order_relaxed);
+        counters.growths = growths_.load(std::memory_order_relaxed);
+        counters.shrinks = shrinks_.load(std::memory_order_relaxed);
+        counters.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+        counters.elements_copied = elements_copied_.load(std::memory_order_relaxed);
+        counters.elements_moved = elements_moved_.load(std::memory_order_relaxed);
+        counters.bytes_copied = bytes_copied_.load(std::memory_order_relaxed);
+        counters.bytes_moved = bytes_moved_.load(std::memory_order_relaxed);
+        counters.wasted_capacity = wasted_capacity_.load(std::memory_order_relaxed);
+        counters.destroyed_vectors = destroyed_vectors_.load(std::memory_order_relaxed);
+        return counters;
+    }
+
+private:
+    std::string type_name_;
+    std::atomic<size_t> allocations_{ 0 };
+    std::atomic<size_t> deallocations_{ 0 };
+    std::atomic<size_t> growths_{ 0 };
+    std::atomic<size_t> shrinks_{ 0 };
+    std::atomic<size_t> peak_capacity_{ 0 };
+    std::atomic<size_t> elements_copied_{ 0 };
+    std::atomic<size_t> elements_moved_{ 0 };
+    std::atomic<size_t> bytes_copied_{ 0 };
+    std::atomic<size_t> bytes_moved_{ 0 };
+    std::atomic<size_t> wasted_capacity_{ 0 };
+    std::atomic<size_t> destroyed_vectors_{ 0 };
+};
+
+// Реестр агрегированных счетчиков всех типов элементов, для выгрузки в систему метрик
+class VectorStatsRegistry
+{
+public:
+    static VectorStatsRegistry& Instance()
+    {
+        static VectorStatsRegistry registry;
+        return registry;
+    }
+
+    // Возвращает счетчики типа Type, регистрируя их при первом обращении
+    template <typename Type>
+    AggregateVectorStats& ForType()
+    {
+        static AggregateVectorStats& stats = Register(TypeName<Type>());
+        return stats;
+    }
+
+    // Вызывает callback(const AggregateVectorStats&) для каждого зарегистрированного типа
+    template <typename Callback>
+    void ForEach(Callback callback) const
+    {
+        std::lock_guard guard(mutex_);
+        for (const auto& stats : stats_)
+        {
+            callback(*stats);
+        }
+    }
+
+    // Выводит счетчики всех типов в формате CSV
+    void Dump(std::ostream& out) const
+    {
+        out << "type,allocations,deallocations,growths,shrinks,peak_capacity,elements_copied,elements_moved,"
+               "bytes_copied,bytes_moved,wasted_capacity,destroyed_vectors\n";
+        ForEach([&out](const AggregateVectorStats& stats)
+            {
+                const VectorStatsCounters c = stats.GetCounters();
+                out << '"' << stats.GetTypeName() << "\"," << c.allocations << ',' << c.deallocations << ','
+                    << c.growths << ',' << c.shrinks << ',' << c.peak_capacity << ',' << c.elements_copied << ',' << c.elements_moved << ','
+                    << c.bytes_copied << ',' << c.bytes_moved << ',' << c.wasted_capacity << ','
+                    << c.destroyed_vectors << '\n';
+            });
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<AggregateVectorStats>> stats_;
+
+    VectorStatsRegistry() = default;
+
+    AggregateVectorStats& Register(std::string type_name)
+    {
+        std::lock_guard guard(mutex_);
+        stats_.push_back(std::make_unique<AggregateVectorStats>(std::move(type_name)));
+        return *stats_.back();
+    }
+
+    template <typename Type>
+    static std::string TypeName()
+    {
+        const char* name = typeid(Type).name();
+#if defined(__GNUG__)
+        int status = 0;
+        std::unique_ptr<char, void (*)(void*)> demangled(abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+        if (status == 0 && demangled)
+        {
+            return demangled.get();
+        }
+#endif
+        return name;
+    }
+};
+
+// Политика статистики по умолчанию: ничего не считает, все методы пустые и встраиваются в ничто.
+// Пустой класс не занимает места в SimpleVector (наследование с оптимизацией пустой базы)
+struct NoVectorStats
+{
+    static constexpr bool enabled = false;
+
+    void OnAllocate(size_t) noexcept
+    {
+    }
+
+    void OnDeallocate(size_t) noexcept
+    {
+    }
+
+    void OnGrowth(size_t, size_t) noexcept
+    {
+    }
+
+    void OnShrink(size_t, size_t) noexcept
+    {
+    }
+
+    void OnCopy(size_t) noexcept
+    {
+    }
+
+    void OnMove(size_t) noexcept
+    {
+    }
+
+    void OnDestroy(size_t, size_t) noexcept
+    {
+    }
+
+    VectorStatsCounters GetCounters() const noexcept
+    {
+        return {};
+    }
+};
+
+// Политика, считающая события одного вектора и дублирующая их в агрегированные счетчики типа Type.
+// Счетчики относятся к объекту вектора и не переносятся вместе с буфером при перемещении и обмене
+template <typename Type>
+class CountingVectorStats
+{
+public:
+    static constexpr bool enabled = true;
+
+    CountingVectorStats() noexcept = default;
+
+    // Новый объект вектора начинает счет с нуля
+    CountingVectorStats(const CountingVectorStats&) noexcept
+    {
+    }
+
+    CountingVectorStats& operator=(const CountingVectorStats&) noexcept
+    {
+        return *this;
+    }
+
+    void OnAllocate(size_t capacity) noexcept
+    {
+        ++counters_.allocations;
+        counters_.peak_capacity = std::max(counters_.peak_capacity, capacity);
+        if (AggregateVectorStats* aggregate = TryAggregate())
+        {
+            aggregate->OnAllocate(capacity);
+        }
+    }
+
+    void OnDeallocate(size_t) noexcept
+    {
+        ++counters_.deallocations;
+        if (AggregateVectorStats* aggregate = TryAggregate())
+        {
+            aggregate->OnDeallocate();
+        }
+    }
+
+    void OnGrowth(size_t, size_t) noexcept
+    {
+        ++counters_.growths;
+        if (AggregateVectorStats* aggregate = TryAggregate())
+        {
+            aggregate->OnGrowth();
+        }
+    }
+
+    void OnShrink(size_t, size_t) noexcept
+    {
+        ++counters_.shrinks;
+        if (AggregateVectorStats* aggregate = TryAggregate())
+        {
+            aggregate->OnShrink();
+        }
+    }
+
+    void OnCopy(size_t count) noexcept
+    {
+        counters_.elements_copied += count;
+        counters_.bytes_copied += count * sizeof(Type);
+        if (AggregateVectorStats* aggregate = TryAggregate())
+        {
+            aggregate->OnCopy(count, count * sizeof(Type));
+        }
+    }
+
+    void OnMove(size_t count) noexcept
+    {
+        counters_.elements_moved += count;
+        counters_.bytes_moved += count * sizeof(Type);
+        if (AggregateVectorStats* aggregate = TryAggregate())
+        {
+            aggregate->OnMove(count, count * sizeof(Type));
+        }
+    }
+
+    void OnDestroy(size_t size, size_t capacity) noexcept
+    {
+        if (AggregateVectorStats* aggregate = TryAggregate())
+        {
+            aggregate->OnDestroy(capacity - size);
+        }
+    }
+
+    VectorStatsCounters GetCounters() const noexcept
+    {
+        return counters_;
+    }
+
+    static AggregateVectorStats& Aggregate()
+    {
+        return VectorStatsRegistry::Instance().ForType<Type>();
+    }
+
+private:
+    VectorStatsCounters counters_;
+
+    // Агрегированные счетчики для событий вектора. Первое обращение регистрирует тип в реестре
+    // (выделяет память и может выбросить исключение), а события приходят из noexcept-операций
+    // вектора: если регистрация не удалась, событие не попадает в агрегат, и регистрация
+    // повторяется при следующем событии
+    static AggregateVectorStats* TryAggregate() noexcept
+    {
+        try
+        {
+            return &Aggregate();
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+};
+
+// Политика статистики SimpleVector по умолчанию. Счетчики включаются для всей программы
+// макросом SIMPLE_VECTOR_ENABLE_STATS (должен быть одинаковым во всех единицах трансляции)
+#ifdef SIMPLE_VECTOR_ENABLE_STATS
+template <typename Type>
+using DefaultVectorStats = CountingVectorStats<Type>;
+#else
+template <typename Type>
+using DefaultVectorStats = NoVectorStats;
+#endif